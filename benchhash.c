@@ -0,0 +1,260 @@
+/*--------------------------------------------------------------------*/
+/* benchhash.c                                                        */
+/*--------------------------------------------------------------------*/
+
+#include "symtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+/* The number of chain lengths that benchChains reports. The last
+   one counts every longer chain too. */
+
+enum {CHAIN_COUNTS = 8};
+
+/* The minimum number of characters that benchThroughput hashes
+   with each hash function. */
+
+enum {MIN_HASHED = 200000000};
+
+/*--------------------------------------------------------------------*/
+
+/* Return the CPU time consumed since iInitialClock in seconds. */
+
+static double secondsSince(clock_t iInitialClock)
+{
+   return ((double)(clock() - iInitialClock)) / CLOCKS_PER_SEC;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return a copy of pcKey. Exit with EXIT_FAILURE if insufficient
+   memory is available. */
+
+static char *copyKey(const char *pcKey)
+{
+   char *pcCopy;
+
+   assert(pcKey != NULL);
+
+   pcCopy = (char*)malloc(strlen(pcKey) + 1);
+   if (pcCopy == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   return strcpy(pcCopy, pcKey);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return an array of iKeyCount keys of the kind that iKind names:
+   0 for the decimal keys of testLargeTable in testsymtable.c, 1 for
+   short identifiers, and 2 for 200 character keys that share all
+   but their last few characters. Exit with EXIT_FAILURE if
+   insufficient memory is available. */
+
+static char **makeKeys(int iKind, int iKeyCount)
+{
+   enum {LONG_KEY_LENGTH = 200};
+
+   char **ppcKeys;
+   char acKey[LONG_KEY_LENGTH + 32];
+   char acSuffix[32];
+   int i;
+
+   ppcKeys = (char**)malloc(sizeof(char*) * (size_t)(iKeyCount + 1));
+   if (ppcKeys == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+
+   for (i = 0; i < iKeyCount; i++)
+   {
+      if (iKind == 0)
+         sprintf(acKey, "%d", i);
+      else if (iKind == 1)
+         sprintf(acKey, "%s_%c%d", (i % 3 == 0) ? "iCount" :
+            (i % 3 == 1) ? "pcName" : "psNode", 'a' + i % 26, i / 26);
+      else
+      {
+         sprintf(acSuffix, "%d", i);
+         memset(acKey, 'a', LONG_KEY_LENGTH - strlen(acSuffix));
+         strcpy(acKey + LONG_KEY_LENGTH - strlen(acSuffix), acSuffix);
+      }
+      ppcKeys[i] = copyKey(acKey);
+   }
+   return ppcKeys;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Free the iKeyCount keys in ppcKeys and ppcKeys itself. */
+
+static void freeKeys(char **ppcKeys, int iKeyCount)
+{
+   int i;
+
+   assert(ppcKeys != NULL);
+
+   for (i = 0; i < iKeyCount; i++)
+      free(ppcKeys[i]);
+   free(ppcKeys);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Hash the iKeyCount keys in ppcKeys with every hash function,
+   repeating until at least MIN_HASHED characters are hashed. Write
+   the throughput of each function in gigabytes per second to
+   stdout. */
+
+static void benchThroughput(char **ppcKeys, int iKeyCount)
+{
+   size_t *puLengths;
+   size_t uCharacters = 0;
+   size_t uHashed;
+   size_t uCheck = 0;
+   double dSeconds;
+   int iFunction;
+   int i;
+   clock_t iInitialClock;
+
+   assert(ppcKeys != NULL);
+
+   if (iKeyCount == 0)
+      return;
+
+   puLengths = (size_t*)malloc(sizeof(size_t) * (size_t)iKeyCount);
+   if (puLengths == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   for (i = 0; i < iKeyCount; i++)
+   {
+      puLengths[i] = strlen(ppcKeys[i]);
+      uCharacters += puLengths[i];
+   }
+
+   for (iFunction = 0; iFunction < SYMHASH_FUNCTION_COUNT; iFunction++)
+   {
+      uHashed = 0;
+      iInitialClock = clock();
+      do
+      {
+         for (i = 0; i < iKeyCount; i++)
+            uCheck ^= SymHash_hash((enum SymHash_Function)iFunction,
+               ppcKeys[i], puLengths[i]);
+         uHashed += uCharacters;
+      } while (uHashed < MIN_HASHED);
+      dSeconds = secondsSince(iInitialClock);
+      printf("%-8s %8.3f GB/s\n",
+         SymHash_name((enum SymHash_Function)iFunction),
+         (dSeconds > 0.0) ? (double)uHashed / dSeconds / 1e9 : 0.0);
+   }
+
+   /* Keeps the compiler from discarding the hash codes. */
+   if (uCheck == 1)
+      printf("\n");
+
+   free(puLengths);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put the iKeyCount keys in ppcKeys into a hash table SymTable that
+   uses each hash function in turn. Write the number of buckets
+   holding each number of bindings to stdout. */
+
+static void benchChains(char **ppcKeys, int iKeyCount)
+{
+   SymTable_T oSymTable;
+   size_t auCounts[CHAIN_COUNTS];
+   int iFunction;
+   int i;
+
+   assert(ppcKeys != NULL);
+
+   printf("chain length:");
+   for (i = 0; i < CHAIN_COUNTS - 1; i++)
+      printf(" %9d", i);
+   printf(" %8d+\n", CHAIN_COUNTS - 1);
+
+   for (iFunction = 0; iFunction < SYMHASH_FUNCTION_COUNT; iFunction++)
+   {
+      oSymTable = SymTable_new();
+      assert(oSymTable != NULL);
+      SymTable_setHashFunction(oSymTable,
+         (enum SymHash_Function)iFunction);
+
+      for (i = 0; i < iKeyCount; i++)
+         SymTable_put(oSymTable, ppcKeys[i], ppcKeys[i]);
+      SymTable_getChainLengths(oSymTable, auCounts, CHAIN_COUNTS);
+
+      printf("%-12s:", SymHash_name((enum SymHash_Function)iFunction));
+      for (i = 0; i < CHAIN_COUNTS; i++)
+         printf(" %9lu", (unsigned long)auCounts[i]);
+      printf("\n");
+
+      SymTable_free(oSymTable);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Benchmark the hash functions that a hash table SymTable can use.
+   Write their throughput and the chain lengths that they produce to
+   stdout. As always, argc is the command-line argument count, argv
+   contains the command-line arguments, and argv[0] is the name of
+   the executable binary file. argv[1] is the number of keys of each
+   kind.  Exit with EXIT_FAILURE if argv[1] is missing or not
+   numeric.  Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   static const char *apcKindNames[] = {
+      "Decimal keys", "Identifier keys", "Long keys with a shared prefix"
+   };
+
+   char **ppcKeys;
+   int iKeyCount;
+   int iKind;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s keycount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iKeyCount) != 1)
+   {
+      fprintf(stderr, "keycount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iKeyCount < 0)
+   {
+      fprintf(stderr, "keycount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   for (iKind = 0; iKind < 3; iKind++)
+   {
+      printf("------------------------------------------------------\n");
+      printf("%s (%d keys):\n", apcKindNames[iKind], iKeyCount);
+      ppcKeys = makeKeys(iKind, iKeyCount);
+      benchThroughput(ppcKeys, iKeyCount);
+      benchChains(ppcKeys, iKeyCount);
+      freeKeys(ppcKeys, iKeyCount);
+      fflush(stdout);
+   }
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
@@ -0,0 +1,155 @@
+/*--------------------------------------------------------------------*/
+/* benchsmall.c                                                       */
+/*--------------------------------------------------------------------*/
+
+#include "symtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+/* The most bindings in each small table, and the number of times
+   each of their keys is looked up. */
+
+enum {MAX_SMALL_BINDINGS = 5};
+enum {LOOKUP_ROUNDS = 8};
+
+/*--------------------------------------------------------------------*/
+
+/* Return the CPU time consumed since iInitialClock in seconds. */
+
+static double secondsSince(clock_t iInitialClock)
+{
+   return ((double)(clock() - iInitialClock)) / CLOCKS_PER_SEC;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put iBindingCount bindings into one large table and look each of
+   them up, and do the same with iTableCount tables of 1 to
+   MAX_SMALL_BINDINGS bindings each, like the inner tables of
+   testTableOfTables in testsymtable.c. Then remove all but one
+   binding of the large table and look the rest up. Write the CPU
+   times consumed to stdout. */
+
+static void benchTables(int iTableCount, int iBindingCount)
+{
+   static const char *const apcFields[MAX_SMALL_BINDINGS] = {
+      "field0", "field1", "field2", "field3", "field4"
+   };
+
+   SymTable_T *poTables;
+   SymTable_T oLarge;
+   char acKey[32];
+   clock_t iInitialClock;
+   long lFound = 0;
+   int iRound;
+   int i;
+   int j;
+
+   poTables = (SymTable_T*)
+      malloc(sizeof(SymTable_T) * (size_t)(iTableCount + 1));
+   if (poTables == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+
+   iInitialClock = clock();
+   for (i = 0; i < iTableCount; i++)
+   {
+      poTables[i] = SymTable_new();
+      assert(poTables[i] != NULL);
+      for (j = 0; j <= i % MAX_SMALL_BINDINGS; j++)
+         SymTable_put(poTables[i], apcFields[j], poTables);
+   }
+   printf("%d small tables, put:  %f seconds\n", iTableCount,
+      secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   for (iRound = 0; iRound < LOOKUP_ROUNDS; iRound++)
+      for (i = 0; i < iTableCount; i++)
+         for (j = 0; j < MAX_SMALL_BINDINGS; j++)
+            if (SymTable_get(poTables[i], apcFields[j]) != NULL)
+               lFound++;
+   printf("%d small tables, get:  %f seconds\n", iTableCount,
+      secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   for (i = 0; i < iTableCount; i++)
+      SymTable_free(poTables[i]);
+   printf("%d small tables, free: %f seconds\n", iTableCount,
+      secondsSince(iInitialClock));
+
+   oLarge = SymTable_new();
+   assert(oLarge != NULL);
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      SymTable_put(oLarge, acKey, poTables);
+   }
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      if (SymTable_get(oLarge, acKey) != NULL)
+         lFound++;
+   }
+   printf("1 large table, put and get: %f seconds\n",
+      secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   for (i = 1; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      SymTable_remove(oLarge, acKey);
+   }
+   for (iRound = 0; iRound < LOOKUP_ROUNDS * iTableCount; iRound++)
+      if (SymTable_get(oLarge, "0") != NULL)
+         lFound++;
+   printf("1 emptied table, remove and get: %f seconds\n",
+      secondsSince(iInitialClock));
+
+   SymTable_free(oLarge);
+   free(poTables);
+   printf("%ld lookups found their key.\n", lFound);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Benchmark whichever SymTable implementation is linked in with
+   many small tables and one large one. Write the CPU times
+   consumed to stdout. As always, argc is the command-line argument
+   count, argv contains the command-line arguments, and argv[0] is
+   the name of the executable binary file. argv[1] is the number of
+   small tables and argv[2] the number of bindings of the large
+   table. Exit with EXIT_FAILURE if either is missing or not a
+   positive number. Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iTableCount;
+   int iBindingCount;
+
+   if (argc != 3)
+   {
+      fprintf(stderr, "Usage: %s tablecount bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+   if (sscanf(argv[1], "%d", &iTableCount) != 1 || iTableCount < 1
+       || sscanf(argv[2], "%d", &iBindingCount) != 1
+       || iBindingCount < 1)
+   {
+      fprintf(stderr, "tablecount and bindingcount must be positive "
+         "numbers\n");
+      exit(EXIT_FAILURE);
+   }
+
+   printf("------------------------------------------------------\n");
+   benchTables(iTableCount, iBindingCount);
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
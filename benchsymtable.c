@@ -0,0 +1,1065 @@
+/*--------------------------------------------------------------------*/
+/* benchsymtable.c                                                    */
+/*--------------------------------------------------------------------*/
+
+/* Exposes clock_gettime under -std=c99. */
+#define _POSIX_C_SOURCE 200809L
+
+#include "symtable.h"
+#include "symthreads.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+/* Return the CPU time consumed since iInitialClock in seconds. */
+
+static double secondsSince(clock_t iInitialClock)
+{
+   return ((double)(clock() - iInitialClock)) / CLOCKS_PER_SEC;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return the wall clock time since *psStart in seconds. The
+   benchmarks of several threads use it, since clock adds up the
+   CPU time of every thread. */
+
+static double wallSecondsSince(const struct timespec *psStart)
+{
+   struct timespec sNow;
+
+   assert(psStart != NULL);
+
+   clock_gettime(CLOCK_MONOTONIC, &sNow);
+   return (double)(sNow.tv_sec - psStart->tv_sec)
+      + (double)(sNow.tv_nsec - psStart->tv_nsec) / 1e9;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return an array of iKeyCount keys, each of which is iKeyLength
+   characters long. Every key starts with the same run of 'a'
+   characters, like the keys of testLongKey in testsymtable.c, and
+   ends with its decimal index prefixed by pcTag. Exit with
+   EXIT_FAILURE if insufficient memory is available. */
+
+static char **makeLongKeys(int iKeyCount, int iKeyLength,
+   const char *pcTag)
+{
+   char **ppcKeys;
+   char acSuffix[32];
+   int i;
+   int iPrefixLength;
+
+   assert(iKeyLength < 10000);
+   assert(pcTag != NULL);
+
+   ppcKeys = (char**)malloc(sizeof(char*) * (size_t)(iKeyCount + 1));
+   if (ppcKeys == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+
+   for (i = 0; i < iKeyCount; i++)
+   {
+      sprintf(acSuffix, "%s%d", pcTag, i);
+      iPrefixLength = iKeyLength - (int)strlen(acSuffix);
+      if (iPrefixLength < 0)
+         iPrefixLength = 0;
+      ppcKeys[i] = (char*)malloc((size_t)iKeyLength + 32);
+      if (ppcKeys[i] == NULL)
+      {
+         fprintf(stderr, "Insufficient memory\n");
+         exit(EXIT_FAILURE);
+      }
+      memset(ppcKeys[i], 'a', (size_t)iPrefixLength);
+      strcpy(ppcKeys[i] + iPrefixLength, acSuffix);
+   }
+   return ppcKeys;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Free the iKeyCount keys in ppcKeys and ppcKeys itself. */
+
+static void freeKeys(char **ppcKeys, int iKeyCount)
+{
+   int i;
+
+   assert(ppcKeys != NULL);
+
+   for (i = 0; i < iKeyCount; i++)
+      free(ppcKeys[i]);
+   free(ppcKeys);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put, get, look up missing keys and remove iBindingCount bindings
+   whose keys are 1000 characters long and share all but their last
+   few characters. Write the CPU time of each phase to stdout. */
+
+static void benchLongKeys(int iBindingCount)
+{
+   enum {KEY_LENGTH = 1000};
+
+   SymTable_T oSymTable;
+   char **ppcKeys;
+   char **ppcMissingKeys;
+   int i;
+   int iFound = 0;
+   clock_t iInitialClock;
+
+   printf("------------------------------------------------------\n");
+   printf("Long keys with a shared prefix (%d bindings):\n",
+      iBindingCount);
+   fflush(stdout);
+
+   ppcKeys = makeLongKeys(iBindingCount, KEY_LENGTH, "");
+   ppcMissingKeys = makeLongKeys(iBindingCount, KEY_LENGTH, "x");
+
+   oSymTable = SymTable_new();
+   assert(oSymTable != NULL);
+
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+      SymTable_put(oSymTable, ppcKeys[i], ppcKeys[i]);
+   printf("put:      %f seconds\n", secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+      iFound += (SymTable_get(oSymTable, ppcKeys[i]) == ppcKeys[i]);
+   printf("get:      %f seconds\n", secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+      iFound += SymTable_contains(oSymTable, ppcMissingKeys[i]);
+   printf("contains: %f seconds (misses)\n",
+      secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+      SymTable_remove(oSymTable, ppcKeys[i]);
+   printf("remove:   %f seconds\n", secondsSince(iInitialClock));
+
+   if (iFound != iBindingCount)
+      printf("Lookups found %d bindings instead of %d.\n", iFound,
+         iBindingCount);
+   fflush(stdout);
+
+   SymTable_free(oSymTable);
+   freeKeys(ppcKeys, iBindingCount);
+   freeKeys(ppcMissingKeys, iBindingCount);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Keep iBindingCount short-lived symbols in a SymTable, putting a
+   new one and removing the oldest one 10 times per binding. Write
+   the CPU time consumed and the share of binding allocations that
+   reused the storage of a removed binding to stdout. */
+
+static void benchChurn(int iBindingCount)
+{
+   enum {CYCLES_PER_BINDING = 10};
+
+   SymTable_T oSymTable;
+   struct SymTable_Stats sStats;
+   char acKey[32];
+   int i;
+   int iCycleCount;
+   clock_t iInitialClock;
+
+   printf("------------------------------------------------------\n");
+   printf("Put and remove churn (%d live bindings):\n",
+      iBindingCount);
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   assert(oSymTable != NULL);
+
+   iCycleCount = iBindingCount * CYCLES_PER_BINDING;
+
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "sym%d", i);
+      SymTable_put(oSymTable, acKey, NULL);
+   }
+   for (i = 0; i < iCycleCount; i++)
+   {
+      sprintf(acKey, "sym%d", iBindingCount + i);
+      SymTable_put(oSymTable, acKey, NULL);
+      sprintf(acKey, "sym%d", i);
+      SymTable_remove(oSymTable, acKey);
+   }
+   printf("churn:    %f seconds\n", secondsSince(iInitialClock));
+
+   SymTable_getStats(oSymTable, &sStats);
+   printf("reused:   %lu of %lu binding allocations\n",
+      (unsigned long)sStats.uBindingReuses,
+      (unsigned long)sStats.uBindingAllocations);
+   if (SymTable_getLength(oSymTable) != (size_t)iBindingCount)
+      printf("The table has %lu bindings instead of %d.\n",
+         (unsigned long)SymTable_getLength(oSymTable), iBindingCount);
+   fflush(stdout);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put iBindingCount bindings whose keys are decimal numbers, like
+   the ones of testLargeTable in testsymtable.c, into a SymTable
+   that pfNew creates, then free it. Write the CPU time of each
+   phase to stdout, labeled with pcName. */
+
+static void benchTeardownOf(int iBindingCount, const char *pcName,
+   SymTable_T (*pfNew)(void))
+{
+   SymTable_T oSymTable;
+   char acKey[32];
+   int i;
+   clock_t iInitialClock;
+
+   assert(pcName != NULL);
+   assert(pfNew != NULL);
+
+   oSymTable = (*pfNew)();
+   assert(oSymTable != NULL);
+
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      SymTable_put(oSymTable, acKey, NULL);
+   }
+   printf("%s put:  %f seconds\n", pcName,
+      secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   SymTable_free(oSymTable);
+   printf("%s free: %f seconds\n", pcName,
+      secondsSince(iInitialClock));
+   fflush(stdout);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Time tearing down a table of iBindingCount bindings created by
+   SymTable_new and by SymTable_newRegion. Write the CPU times to
+   stdout. */
+
+static void benchTeardown(int iBindingCount)
+{
+   printf("------------------------------------------------------\n");
+   printf("Teardown (%d bindings):\n", iBindingCount);
+   fflush(stdout);
+
+   benchTeardownOf(iBindingCount, "new      ", SymTable_new);
+   benchTeardownOf(iBindingCount, "newRegion", SymTable_newRegion);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put the same iKeyCount identifiers into 100 SymTables, first with
+   SymTable_put and then with SymTable_putAtom, and look each of
+   them up in every table. Write the CPU time of each phase and the
+   key bytes that interning saves across the tables to stdout. */
+
+static void benchAtoms(int iKeyCount)
+{
+   enum {TABLE_COUNT = 100};
+
+   SymTable_T aoSymTables[TABLE_COUNT];
+   SymAtom_T *poAtoms;
+   struct SymTable_Stats sStats;
+   char **ppcKeys;
+   char acKey[32];
+   size_t uSharedBytes = 0;
+   size_t uAtomBytes = 0;
+   int i;
+   int j;
+   int iFound = 0;
+   clock_t iInitialClock;
+
+   printf("------------------------------------------------------\n");
+   printf("Interned keys (%d keys in %d tables):\n", iKeyCount,
+      TABLE_COUNT);
+   fflush(stdout);
+
+   ppcKeys = (char**)malloc(sizeof(char*) * (size_t)(iKeyCount + 1));
+   poAtoms = (SymAtom_T*)malloc(sizeof(SymAtom_T)
+      * (size_t)(iKeyCount + 1));
+   if (ppcKeys == NULL || poAtoms == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   for (i = 0; i < iKeyCount; i++)
+   {
+      sprintf(acKey, "identifier_%d", i);
+      ppcKeys[i] = (char*)malloc(strlen(acKey) + 1);
+      if (ppcKeys[i] == NULL)
+      {
+         fprintf(stderr, "Insufficient memory\n");
+         exit(EXIT_FAILURE);
+      }
+      strcpy(ppcKeys[i], acKey);
+   }
+
+   for (j = 0; j < TABLE_COUNT; j++)
+   {
+      aoSymTables[j] = SymTable_new();
+      assert(aoSymTables[j] != NULL);
+   }
+   iInitialClock = clock();
+   for (j = 0; j < TABLE_COUNT; j++)
+      for (i = 0; i < iKeyCount; i++)
+         SymTable_put(aoSymTables[j], ppcKeys[i], ppcKeys[i]);
+   printf("put:      %f seconds\n", secondsSince(iInitialClock));
+   iInitialClock = clock();
+   for (j = 0; j < TABLE_COUNT; j++)
+      for (i = 0; i < iKeyCount; i++)
+         iFound += (SymTable_get(aoSymTables[j], ppcKeys[i])
+            == ppcKeys[i]);
+   printf("get:      %f seconds\n", secondsSince(iInitialClock));
+   for (j = 0; j < TABLE_COUNT; j++)
+      SymTable_free(aoSymTables[j]);
+
+   iInitialClock = clock();
+   for (i = 0; i < iKeyCount; i++)
+   {
+      poAtoms[i] = SymTable_intern(ppcKeys[i]);
+      assert(poAtoms[i] != NULL);
+      uAtomBytes += strlen(ppcKeys[i]) + 1;
+   }
+   printf("intern:   %f seconds\n", secondsSince(iInitialClock));
+
+   for (j = 0; j < TABLE_COUNT; j++)
+   {
+      aoSymTables[j] = SymTable_new();
+      assert(aoSymTables[j] != NULL);
+   }
+   iInitialClock = clock();
+   for (j = 0; j < TABLE_COUNT; j++)
+      for (i = 0; i < iKeyCount; i++)
+         SymTable_putAtom(aoSymTables[j], poAtoms[i], ppcKeys[i]);
+   printf("putAtom:  %f seconds\n", secondsSince(iInitialClock));
+   iInitialClock = clock();
+   for (j = 0; j < TABLE_COUNT; j++)
+      for (i = 0; i < iKeyCount; i++)
+         iFound += (SymTable_getAtom(aoSymTables[j], poAtoms[i])
+            == ppcKeys[i]);
+   printf("getAtom:  %f seconds\n", secondsSince(iInitialClock));
+
+   for (j = 0; j < TABLE_COUNT; j++)
+   {
+      SymTable_getStats(aoSymTables[j], &sStats);
+      uSharedBytes += sStats.uSharedKeyBytes;
+      SymTable_free(aoSymTables[j]);
+   }
+   printf("saved:    %lu key bytes shared, %lu interned, %lu net\n",
+      (unsigned long)uSharedBytes, (unsigned long)uAtomBytes,
+      (unsigned long)(uSharedBytes - uAtomBytes));
+
+   if (iFound != 2 * TABLE_COUNT * iKeyCount)
+      printf("Lookups found %d bindings instead of %d.\n", iFound,
+         2 * TABLE_COUNT * iKeyCount);
+   fflush(stdout);
+
+   freeKeys(ppcKeys, iKeyCount);
+   free(poAtoms);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put iKeyCount 64 character keys into the bottom table of a stack
+   of 8 SymTables, like the scopes of a compiler, and look each key
+   up from the top of the stack down, first with SymTable_get and
+   then with SymTable_getK. Write the CPU time of each to stdout. */
+
+static void benchScopes(int iKeyCount)
+{
+   enum {SCOPE_COUNT = 8};
+   enum {KEY_LENGTH = 64};
+
+   SymTable_T aoScopes[SCOPE_COUNT];
+   SymTable_Key sKey;
+   char **ppcKeys;
+   void *pvValue;
+   int i;
+   int j;
+   int iFound = 0;
+   clock_t iInitialClock;
+
+   printf("------------------------------------------------------\n");
+   printf("Scope stack lookups (%d keys, %d scopes):\n", iKeyCount,
+      SCOPE_COUNT);
+   fflush(stdout);
+
+   ppcKeys = makeLongKeys(iKeyCount, KEY_LENGTH, "");
+   for (j = 0; j < SCOPE_COUNT; j++)
+   {
+      aoScopes[j] = SymTable_new();
+      assert(aoScopes[j] != NULL);
+   }
+   for (i = 0; i < iKeyCount; i++)
+      SymTable_put(aoScopes[0], ppcKeys[i], ppcKeys[i]);
+
+   iInitialClock = clock();
+   for (i = 0; i < iKeyCount; i++)
+   {
+      pvValue = NULL;
+      for (j = SCOPE_COUNT - 1; j >= 0 && pvValue == NULL; j--)
+         pvValue = SymTable_get(aoScopes[j], ppcKeys[i]);
+      iFound += (pvValue == ppcKeys[i]);
+   }
+   printf("get:      %f seconds\n", secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   for (i = 0; i < iKeyCount; i++)
+   {
+      sKey = SymTable_makeKey(ppcKeys[i]);
+      pvValue = NULL;
+      for (j = SCOPE_COUNT - 1; j >= 0 && pvValue == NULL; j--)
+         pvValue = SymTable_getK(aoScopes[j], sKey);
+      iFound += (pvValue == ppcKeys[i]);
+   }
+   printf("getK:     %f seconds\n", secondsSince(iInitialClock));
+
+   if (iFound != 2 * iKeyCount)
+      printf("Lookups found %d bindings instead of %d.\n", iFound,
+         2 * iKeyCount);
+   fflush(stdout);
+
+   for (j = 0; j < SCOPE_COUNT; j++)
+      SymTable_free(aoScopes[j]);
+   freeKeys(ppcKeys, iKeyCount);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put iBindingCount bindings whose keys are decimal numbers, like
+   the ones of testLargeTable in testsymtable.c, into a SymTable
+   that SymTable_new creates and into one that
+   SymTable_newBorrowedKeys creates. The keys outlive both tables.
+   Write the CPU time of the puts into each to stdout. */
+
+static void benchBorrowedKeys(int iBindingCount)
+{
+   SymTable_T oSymTable;
+   char **ppcKeys;
+   char acKey[32];
+   int i;
+   int iPass;
+   clock_t iInitialClock;
+
+   printf("------------------------------------------------------\n");
+   printf("Borrowed keys (%d bindings):\n", iBindingCount);
+   fflush(stdout);
+
+   ppcKeys = (char**)malloc(sizeof(char*)
+      * (size_t)(iBindingCount + 1));
+   if (ppcKeys == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ppcKeys[i] = (char*)malloc(strlen(acKey) + 1);
+      if (ppcKeys[i] == NULL)
+      {
+         fprintf(stderr, "Insufficient memory\n");
+         exit(EXIT_FAILURE);
+      }
+      strcpy(ppcKeys[i], acKey);
+   }
+
+   for (iPass = 0; iPass < 2; iPass++)
+   {
+      if (iPass == 0)
+         oSymTable = SymTable_new();
+      else
+         oSymTable = SymTable_newBorrowedKeys();
+      assert(oSymTable != NULL);
+
+      iInitialClock = clock();
+      for (i = 0; i < iBindingCount; i++)
+         SymTable_put(oSymTable, ppcKeys[i], ppcKeys[i]);
+      printf("%s put: %f seconds\n",
+         (iPass == 0) ? "copied  " : "borrowed",
+         secondsSince(iInitialClock));
+      fflush(stdout);
+
+      SymTable_free(oSymTable);
+   }
+
+   freeKeys(ppcKeys, iBindingCount);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Load iBindingCount bindings whose keys are decimal numbers, like
+   the ones of testLargeTable in testsymtable.c, into an empty
+   SymTable, first with one SymTable_put call per binding and then
+   with one SymTable_putBatch call. Write the CPU time and the
+   number of resizes of each to stdout. */
+
+static void benchBatch(int iBindingCount)
+{
+   SymTable_T oSymTable;
+   struct SymTable_Stats sStats;
+   char **ppcKeys;
+   char acKey[32];
+   size_t uAdded;
+   int i;
+   clock_t iInitialClock;
+
+   printf("------------------------------------------------------\n");
+   printf("Bulk load (%d bindings):\n", iBindingCount);
+   fflush(stdout);
+
+   ppcKeys = (char**)malloc(sizeof(char*)
+      * (size_t)(iBindingCount + 1));
+   if (ppcKeys == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ppcKeys[i] = (char*)malloc(strlen(acKey) + 1);
+      if (ppcKeys[i] == NULL)
+      {
+         fprintf(stderr, "Insufficient memory\n");
+         exit(EXIT_FAILURE);
+      }
+      strcpy(ppcKeys[i], acKey);
+   }
+
+   oSymTable = SymTable_new();
+   assert(oSymTable != NULL);
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+      SymTable_put(oSymTable, ppcKeys[i], ppcKeys[i]);
+   SymTable_getStats(oSymTable, &sStats);
+   printf("put:      %f seconds, %lu resizes\n",
+      secondsSince(iInitialClock), (unsigned long)sStats.uResizes);
+   SymTable_free(oSymTable);
+
+   oSymTable = SymTable_new();
+   assert(oSymTable != NULL);
+   iInitialClock = clock();
+   uAdded = SymTable_putBatch(oSymTable, (const char *const *)ppcKeys,
+      (const void *const *)ppcKeys, (size_t)iBindingCount, NULL);
+   SymTable_getStats(oSymTable, &sStats);
+   printf("putBatch: %f seconds, %lu resizes\n",
+      secondsSince(iInitialClock), (unsigned long)sStats.uResizes);
+   if (uAdded != (size_t)iBindingCount)
+      printf("SymTable_putBatch added %lu bindings instead of %d.\n",
+         (unsigned long)uAdded, iBindingCount);
+   fflush(stdout);
+   SymTable_free(oSymTable);
+
+   freeKeys(ppcKeys, iBindingCount);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Look up iBindingCount keys in a SymTable of iBindingCount
+   bindings, in a random order, first with one SymTable_get call per
+   key and then with SymTable_getMany calls of 1024 keys. Write the
+   CPU time of each to stdout. A table of a few million bindings is
+   much larger than the last level cache. */
+
+static void benchGetMany(int iBindingCount)
+{
+   enum {BATCH_SIZE = 1024};
+
+   SymTable_T oSymTable;
+   char **ppcKeys;
+   const char **ppcLookups;
+   void *apvValues[BATCH_SIZE];
+   char acKey[32];
+   size_t uFound = 0;
+   size_t uBatch;
+   double dGetSeconds;
+   double dGetManySeconds;
+   int i;
+   int j;
+   clock_t iInitialClock;
+
+   printf("------------------------------------------------------\n");
+   printf("Random lookups (%d bindings):\n", iBindingCount);
+   fflush(stdout);
+
+   ppcKeys = (char**)malloc(sizeof(char*)
+      * (size_t)(iBindingCount + 1));
+   ppcLookups = (const char**)malloc(sizeof(char*)
+      * (size_t)(iBindingCount + 1));
+   if (ppcKeys == NULL || ppcLookups == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+
+   oSymTable = SymTable_new();
+   assert(oSymTable != NULL);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ppcKeys[i] = (char*)malloc(strlen(acKey) + 1);
+      if (ppcKeys[i] == NULL)
+      {
+         fprintf(stderr, "Insufficient memory\n");
+         exit(EXIT_FAILURE);
+      }
+      strcpy(ppcKeys[i], acKey);
+      SymTable_put(oSymTable, ppcKeys[i], ppcKeys[i]);
+   }
+
+   /* shuffles the keys so that consecutive lookups touch unrelated
+      cache lines */
+   srand(217);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      j = rand() % (i + 1);
+      if (j != i)
+         ppcLookups[i] = ppcLookups[j];
+      ppcLookups[j] = ppcKeys[i];
+   }
+
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i++)
+      uFound += (SymTable_get(oSymTable, ppcLookups[i]) != NULL);
+   dGetSeconds = secondsSince(iInitialClock);
+   printf("get:      %f seconds\n", dGetSeconds);
+
+   iInitialClock = clock();
+   for (i = 0; i < iBindingCount; i += BATCH_SIZE)
+   {
+      uBatch = (size_t)(iBindingCount - i);
+      if (uBatch > BATCH_SIZE)
+         uBatch = BATCH_SIZE;
+      uFound += SymTable_getMany(oSymTable, ppcLookups + i, uBatch,
+         apvValues);
+   }
+   dGetManySeconds = secondsSince(iInitialClock);
+   printf("getMany:  %f seconds", dGetManySeconds);
+   if (dGetManySeconds > 0.0)
+      printf(" (%.2fx)", dGetSeconds / dGetManySeconds);
+   printf("\n");
+
+   if (uFound != 2 * (size_t)iBindingCount)
+      printf("Lookups found %lu bindings instead of %d.\n",
+         (unsigned long)uFound, 2 * iBindingCount);
+   fflush(stdout);
+
+   SymTable_free(oSymTable);
+   freeKeys(ppcKeys, iBindingCount);
+   free(ppcLookups);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Add a checksum of pcKey and the value that pvValue points to
+   into the unsigned long that pvSum points to. The checksum is
+   repeated, as a callback that serializes its binding would be, so
+   that each call costs about a microsecond. */
+
+static void checksumBinding(const char *pcKey, void *pvValue,
+   void *pvSum)
+{
+   enum {ROUNDS = 64};
+
+   unsigned long ulSum = *(int*)pvValue;
+   const char *pc;
+   int iRound;
+
+   assert(pcKey != NULL);
+   assert(pvSum != NULL);
+
+   for (iRound = 0; iRound < ROUNDS; iRound++)
+      for (pc = pcKey; *pc != '\0'; pc++)
+         ulSum = ulSum * 31 + (unsigned long)*pc
+            + (unsigned long)iRound;
+   *(unsigned long*)pvSum += ulSum;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return a new unsigned long sum of 0 for one thread of
+   SymTable_mapReduce. Exit with EXIT_FAILURE if insufficient memory
+   is available. */
+
+static void *beginSum(void *pvTotal)
+{
+   unsigned long *pulSum;
+
+   (void)pvTotal;
+   pulSum = (unsigned long*)calloc(1, sizeof(unsigned long));
+   if (pulSum == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   return pulSum;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Add the sum of one thread of SymTable_mapReduce, which pvSum
+   points to, into the total that pvTotal points to, and free it. */
+
+static void endSum(void *pvSum, void *pvTotal)
+{
+   assert(pvSum != NULL);
+   assert(pvTotal != NULL);
+
+   *(unsigned long*)pvTotal += *(unsigned long*)pvSum;
+   free(pvSum);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Checksum iBindingCount bindings with SymTable_map and with
+   SymTable_mapReduce on 1 up to twice the number of processors
+   threads, and write the wall clock times to stdout. */
+
+static void benchMapParallel(int iBindingCount)
+{
+   SymTable_T oSymTable;
+   int *piValues;
+   char acKey[32];
+   unsigned long ulExpected = 0;
+   unsigned long ulSum;
+   size_t uThreads;
+   size_t uMaxThreads;
+   double dMapSeconds;
+   double dSeconds;
+   struct timespec sStart;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Checksum every binding (%d bindings):\n", iBindingCount);
+   fflush(stdout);
+
+   piValues = (int*)malloc(sizeof(int) * (size_t)(iBindingCount + 1));
+   if (piValues == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   oSymTable = SymTable_new();
+   assert(oSymTable != NULL);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      piValues[i] = i;
+      sprintf(acKey, "%d", i);
+      SymTable_put(oSymTable, acKey, &piValues[i]);
+   }
+
+   clock_gettime(CLOCK_MONOTONIC, &sStart);
+   SymTable_map(oSymTable, checksumBinding, &ulExpected);
+   dMapSeconds = wallSecondsSince(&sStart);
+   printf("map:              %f seconds\n", dMapSeconds);
+
+   uMaxThreads = 2 * SymThreads_processorCount();
+   for (uThreads = 1; uThreads <= uMaxThreads; uThreads *= 2)
+   {
+      ulSum = 0;
+      clock_gettime(CLOCK_MONOTONIC, &sStart);
+      SymTable_mapReduce(oSymTable, checksumBinding, beginSum, endSum,
+         &ulSum, uThreads);
+      dSeconds = wallSecondsSince(&sStart);
+      printf("mapReduce %3lu:    %f seconds", (unsigned long)uThreads,
+         dSeconds);
+      if (dSeconds > 0.0)
+         printf(" (%.2fx)", dMapSeconds / dSeconds);
+      printf("\n");
+      if (ulSum != ulExpected)
+         printf("The checksums of the threads add up to %lu instead "
+            "of %lu.\n", ulSum, ulExpected);
+      fflush(stdout);
+   }
+
+   SymTable_free(oSymTable);
+   free(piValues);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Add the int that pvValue points to to the unsigned long that
+   pvSum points to. pcKey is unused. */
+
+static void addValue(const char *pcKey, void *pvValue, void *pvSum)
+{
+   assert(pvValue != NULL);
+   assert(pvSum != NULL);
+   (void)pcKey;
+
+   *(unsigned long*)pvSum += (unsigned long)*(int*)pvValue;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Sum the values of iBindingCount bindings with SymTable_map, with
+   one scan of SymTable_iterNext calls, and with scans that stop
+   after every 1000 bindings and search the table before they
+   continue, like a scan that is spread across the ticks of an
+   event loop. Write the CPU times consumed to stdout. */
+
+static void benchIterate(int iBindingCount)
+{
+   enum {SLICE = 1000};
+
+   SymTable_T oSymTable;
+   struct SymTable_Iter sIter;
+   int *piValues;
+   void *pvValue;
+   char acKey[32];
+   unsigned long ulExpected = 0;
+   unsigned long ulSum = 0;
+   unsigned long ulSliced = 0;
+   clock_t iInitialClock;
+   int iMore;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Sum every value (%d bindings):\n", iBindingCount);
+   fflush(stdout);
+
+   piValues = (int*)malloc(sizeof(int) * (size_t)(iBindingCount + 1));
+   if (piValues == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   oSymTable = SymTable_new();
+   assert(oSymTable != NULL);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      piValues[i] = i;
+      sprintf(acKey, "%d", i);
+      SymTable_put(oSymTable, acKey, &piValues[i]);
+   }
+
+   iInitialClock = clock();
+   SymTable_map(oSymTable, addValue, &ulExpected);
+   printf("map:              %f seconds\n",
+      secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   SymTable_iterBegin(oSymTable, &sIter);
+   while (SymTable_iterNext(oSymTable, &sIter, NULL, &pvValue))
+      ulSum += (unsigned long)*(int*)pvValue;
+   printf("iterNext:         %f seconds\n",
+      secondsSince(iInitialClock));
+
+   iInitialClock = clock();
+   SymTable_iterBegin(oSymTable, &sIter);
+   for (iMore = 1; iMore; )
+   {
+      for (i = 0; i < SLICE; i++)
+      {
+         iMore = SymTable_iterNext(oSymTable, &sIter, NULL, &pvValue);
+         if (!iMore)
+            break;
+         ulSliced += (unsigned long)*(int*)pvValue;
+      }
+      SymTable_contains(oSymTable, "0");
+   }
+   printf("iterNext sliced:  %f seconds\n",
+      secondsSince(iInitialClock));
+
+   if (ulSum != ulExpected || ulSliced != ulExpected)
+      printf("The scans add up to %lu and %lu instead of %lu.\n",
+         ulSum, ulSliced, ulExpected);
+
+   SymTable_free(oSymTable);
+   free(piValues);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put iBindingCount bindings into a new hash table whose resizes
+   with at least uThreshold bindings move them with uThreads
+   threads, timing each SymTable_put with the wall clock. Return the
+   time of the slowest SymTable_put in seconds, which is the last
+   resize, and store the number of bindings that it moved in
+   *piMoved. */
+
+static double slowestPut(int iBindingCount, size_t uThreshold,
+   size_t uThreads, int *piMoved)
+{
+   SymTable_T oSymTable;
+   char acKey[32];
+   struct timespec sStart;
+   double dSlowest = 0.0;
+   double dSeconds;
+   int i;
+
+   assert(piMoved != NULL);
+
+   oSymTable = SymTable_new();
+   assert(oSymTable != NULL);
+   SymTable_setParallelResize(oSymTable, uThreshold, uThreads);
+
+   *piMoved = 0;
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      clock_gettime(CLOCK_MONOTONIC, &sStart);
+      SymTable_put(oSymTable, acKey, NULL);
+      dSeconds = wallSecondsSince(&sStart);
+      if (dSeconds > dSlowest)
+      {
+         dSlowest = dSeconds;
+         *piMoved = i;
+      }
+   }
+
+   SymTable_free(oSymTable);
+   return dSlowest;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Grow hash tables to 2^14, 2^15, ... and finally iBindingCount
+   bindings, and compare the slowest SymTable_put of each, which is
+   its last resize, when every resize moves the bindings on the
+   calling thread and when every resize moves them with one thread
+   per online processor, but at least two. Write the times to
+   stdout, so that the binding count from which moving the bindings
+   with several threads is faster can be read off, and passed to
+   SymTable_setParallelResize. */
+
+static void benchParallelResize(int iBindingCount)
+{
+   size_t uThreads;
+   double dSerial;
+   double dParallel;
+   int iMoved;
+   int iUnused;
+   int iCount;
+
+   uThreads = SymThreads_processorCount();
+   if (uThreads < 2)
+      uThreads = 2;
+
+   printf("------------------------------------------------------\n");
+   printf("Slowest put, which is the last resize, with 1 and %lu "
+      "threads:\n", (unsigned long)uThreads);
+   fflush(stdout);
+
+   for (iCount = 1 << 14; ; iCount *= 2)
+   {
+      if (iCount > iBindingCount || iCount > INT_MAX / 2)
+         iCount = iBindingCount;
+      dSerial = slowestPut(iCount, (size_t)-1, 1, &iMoved);
+      dParallel = slowestPut(iCount, 0, uThreads, &iUnused);
+      printf("%10d bindings: %10f seconds %10f seconds",
+         iMoved, dSerial, dParallel);
+      if (dParallel > 0.0)
+         printf(" (%.2fx)", dSerial / dParallel);
+      printf("\n");
+      fflush(stdout);
+      if (iCount == iBindingCount)
+         break;
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Run benchAtoms with iBindingCount keys, but at most 5000, since
+   every key is put into each of its tables. */
+
+static void benchAtomsCapped(int iBindingCount)
+{
+   benchAtoms(iBindingCount < 5000 ? iBindingCount : 5000);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Benchmark the hash table SymTable implementation.  Write the CPU
+   times consumed to stdout. As always, argc is the command-line
+   argument count, argv contains the command-line arguments, and
+   argv[0] is the name of the executable binary file. argv[1] is
+   the number of bindings each benchmark uses. argv[2], if present,
+   is the name of the only benchmark to run.  Exit with
+   EXIT_FAILURE if argv[1] is missing or not numeric, or if argv[2]
+   names no benchmark.  Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   static const struct Benchmark
+   {
+      const char *pcName;
+      void (*pfBench)(int iBindingCount);
+   } asBenchmarks[] = {
+      {"longkeys", benchLongKeys},
+      {"churn", benchChurn},
+      {"teardown", benchTeardown},
+      {"atoms", benchAtomsCapped},
+      {"scopes", benchScopes},
+      {"borrowed", benchBorrowedKeys},
+      {"batch", benchBatch},
+      {"getmany", benchGetMany},
+      {"mapparallel", benchMapParallel},
+      {"rehash", benchParallelResize},
+      {"iterate", benchIterate}
+   };
+   enum {BENCHMARK_COUNT =
+      sizeof(asBenchmarks) / sizeof(asBenchmarks[0])};
+
+   int iBindingCount;
+   int iRan = 0;
+   int i;
+
+   if (argc != 2 && argc != 3)
+   {
+      fprintf(stderr, "Usage: %s bindingcount [benchmark]\n",
+         argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   for (i = 0; i < BENCHMARK_COUNT; i++)
+      if (argc == 2 || strcmp(argv[2], asBenchmarks[i].pcName) == 0)
+      {
+         (*asBenchmarks[i].pfBench)(iBindingCount);
+         iRan++;
+      }
+   if (iRan == 0)
+   {
+      fprintf(stderr, "benchmark must be one of:");
+      for (i = 0; i < BENCHMARK_COUNT; i++)
+         fprintf(stderr, " %s", asBenchmarks[i].pcName);
+      fprintf(stderr, "\n");
+      exit(EXIT_FAILURE);
+   }
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
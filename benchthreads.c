@@ -0,0 +1,318 @@
+/*--------------------------------------------------------------------*/
+/* benchthreads.c                                                     */
+/*--------------------------------------------------------------------*/
+
+/* Exposes pthreads, clock_gettime and sysconf under -std=c99. */
+#define _POSIX_C_SOURCE 200809L
+
+#include "symtable.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+/* The number of operations that each run performs in total, divided
+   evenly among its threads. */
+
+enum {OPS_PER_RUN = 4000000};
+
+/* The number of stripes of the table that stands in for one table
+   behind a single global lock, and of the striped tables. */
+
+enum {GLOBAL_LOCK_STRIPES = 1};
+enum {STRIPE_COUNT = 64};
+
+/* The number of shards of the sharded table, and of the stripes of
+   each of its shards. */
+
+enum {SHARD_COUNT = 16};
+enum {SHARD_STRIPE_COUNT = 4};
+
+/* The length of the longest key. */
+
+enum {MAX_KEY_LENGTH = 15};
+
+/*--------------------------------------------------------------------*/
+
+/* A Config describes one kind of table that the benchmark runs. */
+
+struct Config
+{
+   /* The name that the results of the kind are written with. */
+   const char *pcName;
+
+   /* The number of shards of the table, and of the stripes of each
+      shard. */
+   size_t uShardCount;
+   size_t uStripeCount;
+
+   /* 1 (TRUE) if SymTable_get takes no lock, or 0 (FALSE). */
+   int iLockFreeReads;
+};
+
+/*--------------------------------------------------------------------*/
+
+/* A Worker holds what one thread of a run needs. */
+
+struct Worker
+{
+   /* The table that every thread of the run uses. */
+   SymTable_T oSymTable;
+
+   /* The keys, of which the first half was put before the run. */
+   char (*pacKeys)[MAX_KEY_LENGTH + 1];
+   unsigned long ulKeyCount;
+
+   /* The number of operations to perform, and the percentage of
+      them that are SymTable_get. The rest put or remove a key. */
+   unsigned long ulOps;
+   int iReadPercent;
+
+   /* The state of the random number generator of the thread. */
+   unsigned long ulSeed;
+
+   /* The number of keys that SymTable_get found, which keeps the
+      compiler from discarding the lookups. */
+   unsigned long ulFound;
+};
+
+/*--------------------------------------------------------------------*/
+
+/* Return the wall clock time since *psStart in seconds. */
+
+static double secondsSince(const struct timespec *psStart)
+{
+   struct timespec sNow;
+
+   assert(psStart != NULL);
+
+   clock_gettime(CLOCK_MONOTONIC, &sNow);
+   return (double)(sNow.tv_sec - psStart->tv_sec)
+      + (double)(sNow.tv_nsec - psStart->tv_nsec) / 1e9;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Advance the random number generator whose state is *pulSeed and
+   return its next value. */
+
+static unsigned long nextRandom(unsigned long *pulSeed)
+{
+   assert(pulSeed != NULL);
+
+   *pulSeed = *pulSeed * 6364136223846793005UL + 1442695040888963407UL;
+   return *pulSeed >> 17;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Perform the operations of the Worker that pvWorker points to on
+   randomly chosen keys. A write puts the key if it is absent and
+   removes it otherwise, so the table stays about half full. Return
+   NULL. */
+
+static void *runWorker(void *pvWorker)
+{
+   struct Worker *psWorker = (struct Worker*)pvWorker;
+   const char *pcKey;
+   unsigned long ulRandom;
+   unsigned long ul;
+
+   assert(psWorker != NULL);
+
+   for (ul = 0; ul < psWorker->ulOps; ul++)
+   {
+      ulRandom = nextRandom(&psWorker->ulSeed);
+      pcKey = psWorker->pacKeys[ulRandom % psWorker->ulKeyCount];
+      if ((int)((ulRandom >> 32) % 100) < psWorker->iReadPercent)
+      {
+         if (SymTable_get(psWorker->oSymTable, pcKey) != NULL)
+            psWorker->ulFound++;
+      }
+      else if (!SymTable_put(psWorker->oSymTable, pcKey, pcKey))
+         SymTable_remove(psWorker->oSymTable, pcKey);
+   }
+   return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put the first half of the ulKeyCount keys in pacKeys into a table
+   of the kind that *psConfig describes, then perform OPS_PER_RUN
+   operations, iReadPercent percent of them SymTable_get, on
+   iThreadCount threads at once. Return the number of millions of
+   operations per second. Exit with EXIT_FAILURE if insufficient
+   memory is available or a thread cannot be created. */
+
+static double benchRun(char (*pacKeys)[MAX_KEY_LENGTH + 1],
+   unsigned long ulKeyCount, const struct Config *psConfig,
+   int iReadPercent, int iThreadCount)
+{
+   SymTable_T oSymTable;
+   struct Worker *psWorkers;
+   pthread_t *psThreads;
+   struct timespec sStart;
+   double dSeconds;
+   unsigned long ul;
+   int i;
+
+   assert(pacKeys != NULL);
+   assert(psConfig != NULL);
+   assert(iThreadCount > 0);
+
+   if (psConfig->iLockFreeReads)
+      oSymTable = SymTable_newLockFreeReads(psConfig->uStripeCount);
+   else
+      oSymTable = SymTable_newSharded(psConfig->uShardCount,
+         psConfig->uStripeCount);
+   psWorkers = (struct Worker*)
+      malloc(sizeof(struct Worker) * (size_t)iThreadCount);
+   psThreads = (pthread_t*)
+      malloc(sizeof(pthread_t) * (size_t)iThreadCount);
+   if (oSymTable == NULL || psWorkers == NULL || psThreads == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+
+   for (ul = 0; ul < ulKeyCount / 2; ul++)
+      SymTable_put(oSymTable, pacKeys[ul], pacKeys[ul]);
+
+   for (i = 0; i < iThreadCount; i++)
+   {
+      psWorkers[i].oSymTable = oSymTable;
+      psWorkers[i].pacKeys = pacKeys;
+      psWorkers[i].ulKeyCount = ulKeyCount;
+      psWorkers[i].ulOps = OPS_PER_RUN / (unsigned long)iThreadCount;
+      psWorkers[i].iReadPercent = iReadPercent;
+      psWorkers[i].ulSeed = (unsigned long)i * 2654435761UL + 1;
+      psWorkers[i].ulFound = 0;
+   }
+
+   clock_gettime(CLOCK_MONOTONIC, &sStart);
+   for (i = 0; i < iThreadCount; i++)
+      if (pthread_create(&psThreads[i], NULL, runWorker,
+            &psWorkers[i]) != 0)
+      {
+         fprintf(stderr, "Cannot create thread\n");
+         exit(EXIT_FAILURE);
+      }
+   for (i = 0; i < iThreadCount; i++)
+      pthread_join(psThreads[i], NULL);
+   dSeconds = secondsSince(&sStart);
+
+   SymTable_free(oSymTable);
+   free(psThreads);
+   free(psWorkers);
+
+   return (dSeconds > 0.0) ? (double)(OPS_PER_RUN
+      / (unsigned long)iThreadCount * (unsigned long)iThreadCount)
+      / dSeconds / 1e6 : 0.0;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Benchmark a concurrent SymTable with 1 to the maximum number of
+   threads, with 90/10 and 50/50 mixes of reads and writes, against
+   the same table with one stripe, which behaves like a table behind
+   a single global lock, against a table of independently resized
+   shards, and against a table whose reads take no lock. Write the
+   throughput of each run and its speedup over one thread to
+   stdout. As always, argc is the command-line argument count, argv
+   contains the command-line arguments, and argv[0] is the name of
+   the executable binary file. argv[1] is the number of keys, half
+   of which are in the table at any time, and the optional argv[2]
+   is the maximum number of threads, which defaults to the number
+   of online processors. Exit with EXIT_FAILURE if an argument is
+   missing or invalid. Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   static const int aiReadPercents[] = {90, 50};
+   static const struct Config asConfigs[] = {
+      {"global lock", 1, GLOBAL_LOCK_STRIPES, 0},
+      {"striped", 1, STRIPE_COUNT, 0},
+      {"sharded", SHARD_COUNT, SHARD_STRIPE_COUNT, 0},
+      {"lock-free reads", 1, STRIPE_COUNT, 1}
+   };
+
+   char (*pacKeys)[MAX_KEY_LENGTH + 1];
+   unsigned long ulKeyCount;
+   unsigned long ul;
+   int iMaxThreads;
+   int iThreadCount;
+   int iMix;
+   size_t uConfig;
+   double dOneThread;
+   double dMops;
+
+   if (argc != 2 && argc != 3)
+   {
+      fprintf(stderr, "Usage: %s keycount [maxthreads]\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+   if (sscanf(argv[1], "%lu", &ulKeyCount) != 1 || ulKeyCount < 2)
+   {
+      fprintf(stderr, "keycount must be a number of at least 2\n");
+      exit(EXIT_FAILURE);
+   }
+   if (argc == 3)
+   {
+      if (sscanf(argv[2], "%d", &iMaxThreads) != 1 || iMaxThreads < 1)
+      {
+         fprintf(stderr, "maxthreads must be a positive number\n");
+         exit(EXIT_FAILURE);
+      }
+   }
+   else
+   {
+      iMaxThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+      if (iMaxThreads < 1)
+         iMaxThreads = 1;
+   }
+
+   pacKeys = (char (*)[MAX_KEY_LENGTH + 1])
+      malloc(sizeof(*pacKeys) * (size_t)ulKeyCount);
+   if (pacKeys == NULL)
+   {
+      fprintf(stderr, "Insufficient memory\n");
+      exit(EXIT_FAILURE);
+   }
+   for (ul = 0; ul < ulKeyCount; ul++)
+      sprintf(pacKeys[ul], "%lu", ul);
+
+   for (iMix = 0; iMix < 2; iMix++)
+   {
+      printf("------------------------------------------------------\n");
+      printf("%d%% reads, %d%% writes, %lu keys:\n",
+         aiReadPercents[iMix], 100 - aiReadPercents[iMix], ulKeyCount);
+      for (uConfig = 0;
+           uConfig < sizeof(asConfigs) / sizeof(asConfigs[0]);
+           uConfig++)
+      {
+         dOneThread = 0.0;
+         for (iThreadCount = 1; iThreadCount <= iMaxThreads;
+              iThreadCount++)
+         {
+            dMops = benchRun(pacKeys, ulKeyCount, &asConfigs[uConfig],
+               aiReadPercents[iMix], iThreadCount);
+            if (iThreadCount == 1)
+               dOneThread = dMops;
+            printf("%-16s %3d thread%s %8.2f Mops/s %6.2fx\n",
+               asConfigs[uConfig].pcName, iThreadCount,
+               (iThreadCount == 1) ? " " : "s", dMops,
+               (dOneThread > 0.0) ? dMops / dOneThread : 0.0);
+            fflush(stdout);
+         }
+      }
+   }
+
+   free(pacKeys);
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
@@ -0,0 +1,216 @@
+/* implements the hash functions that a SymTable can use */
+
+/* includes libraries*/
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include "symhash.h"
+
+/* the constants that the wyhash style hash mixes into its input */
+static const uint64_t wySecret[] = {
+   UINT64_C(0xa0761d6478bd642f), UINT64_C(0xe7037ed1a0b428db),
+   UINT64_C(0x8ebc6af09c88c6e3), UINT64_C(0x589965cc75374cc3)};
+
+/* Takes in a key, pcKey, and its length, uLength. Returns the
+   hash code of the assignment specification's hash function. */
+static size_t SymHash_legacy(const char *pcKey, size_t uLength) {
+   const size_t HASH_MULTIPLIER = 65599;
+   size_t u;
+   size_t uHash = 0;
+
+   assert(pcKey != NULL);
+
+   /* calulates the hash value */
+   for (u = 0; u < uLength; u++)
+      uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];
+
+   return uHash;
+}
+
+/* Takes in a key, pcKey, and its length, uLength. Returns the
+   64 bit FNV-1a hash code of pcKey. */
+static size_t SymHash_fnv1a(const char *pcKey, size_t uLength) {
+   const uint64_t FNV_OFFSET_BASIS = UINT64_C(0xcbf29ce484222325);
+   const uint64_t FNV_PRIME = UINT64_C(0x100000001b3);
+   uint64_t uHash = FNV_OFFSET_BASIS;
+   size_t u;
+
+   assert(pcKey != NULL);
+
+   for (u = 0; u < uLength; u++) {
+      uHash ^= (unsigned char)pcKey[u];
+      uHash *= FNV_PRIME;
+   }
+   return (size_t)uHash;
+}
+
+/* Takes in two 64 bit values, *puA and *puB, and replaces them
+   with the low and high halves of their 128 bit product. */
+static void SymHash_multiply(uint64_t *puA, uint64_t *puB) {
+#ifdef __SIZEOF_INT128__
+   __extension__ unsigned __int128 uProduct = *puA;
+   uProduct *= *puB;
+   *puA = (uint64_t)uProduct;
+   *puB = (uint64_t)(uProduct >> 64);
+#else
+   /* multiplies the 32 bit halves and adds up the partial
+      products */
+   uint64_t uAHigh = *puA >> 32, uALow = (uint32_t)*puA;
+   uint64_t uBHigh = *puB >> 32, uBLow = (uint32_t)*puB;
+   uint64_t uHighHigh = uAHigh * uBHigh, uHighLow = uAHigh * uBLow;
+   uint64_t uLowHigh = uALow * uBHigh, uLowLow = uALow * uBLow;
+   uint64_t uMiddle = uHighLow + (uLowLow >> 32) + (uint32_t)uLowHigh;
+
+   *puA = (uMiddle << 32) | (uint32_t)uLowLow;
+   *puB = uHighHigh + (uMiddle >> 32) + (uLowHigh >> 32);
+#endif
+}
+
+/* Takes in two 64 bit values, uA and uB, and returns the
+   exclusive or of the halves of their 128 bit product. */
+static uint64_t SymHash_mix(uint64_t uA, uint64_t uB) {
+   SymHash_multiply(&uA, &uB);
+   return uA ^ uB;
+}
+
+/* Takes in the address of 8 characters, pc, and returns them as a
+   little endian 64 bit value. */
+static uint64_t SymHash_read8(const char *pc) {
+   const unsigned char *puc = (const unsigned char *)pc;
+
+   return (uint64_t)puc[0] | (uint64_t)puc[1] << 8
+      | (uint64_t)puc[2] << 16 | (uint64_t)puc[3] << 24
+      | (uint64_t)puc[4] << 32 | (uint64_t)puc[5] << 40
+      | (uint64_t)puc[6] << 48 | (uint64_t)puc[7] << 56;
+}
+
+/* Takes in the address of 4 characters, pc, and returns them as a
+   little endian 32 bit value. */
+static uint64_t SymHash_read4(const char *pc) {
+   const unsigned char *puc = (const unsigned char *)pc;
+
+   return (uint64_t)puc[0] | (uint64_t)puc[1] << 8
+      | (uint64_t)puc[2] << 16 | (uint64_t)puc[3] << 24;
+}
+
+/* Takes in a key, pcKey, and its length, uLength. Returns the
+   wyhash style hash code of pcKey. Keys of up to 16 characters are
+   read with at most four overlapping loads, and longer keys 16 or
+   48 characters per iteration. */
+static size_t SymHash_wy(const char *pcKey, size_t uLength) {
+   uint64_t uSeed = wySecret[0];
+   uint64_t uA;
+   uint64_t uB;
+   const char *pc = pcKey;
+
+   assert(pcKey != NULL);
+
+   uSeed ^= SymHash_mix(uSeed ^ wySecret[0], wySecret[1]);
+   if (uLength <= 16) {
+      if (uLength >= 4) {
+         size_t uOffset = (uLength >> 3) << 2;
+         uA = (SymHash_read4(pc) << 32) | SymHash_read4(pc + uOffset);
+         uB = (SymHash_read4(pc + uLength - 4) << 32)
+            | SymHash_read4(pc + uLength - 4 - uOffset);
+      }
+      else if (uLength > 0) {
+         const unsigned char *puc = (const unsigned char *)pc;
+         uA = ((uint64_t)puc[0] << 16)
+            | ((uint64_t)puc[uLength >> 1] << 8) | puc[uLength - 1];
+         uB = 0;
+      }
+      else
+         uA = uB = 0;
+   }
+   else {
+      size_t uLeft = uLength;
+
+      /* mixes 48 characters per iteration into three lanes */
+      if (uLeft > 48) {
+         uint64_t uSeed1 = uSeed;
+         uint64_t uSeed2 = uSeed;
+         do {
+            uSeed = SymHash_mix(SymHash_read8(pc) ^ wySecret[1],
+                                SymHash_read8(pc + 8) ^ uSeed);
+            uSeed1 = SymHash_mix(SymHash_read8(pc + 16) ^ wySecret[2],
+                                 SymHash_read8(pc + 24) ^ uSeed1);
+            uSeed2 = SymHash_mix(SymHash_read8(pc + 32) ^ wySecret[3],
+                                 SymHash_read8(pc + 40) ^ uSeed2);
+            pc += 48;
+            uLeft -= 48;
+         } while (uLeft > 48);
+         uSeed ^= uSeed1 ^ uSeed2;
+      }
+
+      /* mixes the remaining characters 16 at a time */
+      while (uLeft > 16) {
+         uSeed = SymHash_mix(SymHash_read8(pc) ^ wySecret[1],
+                             SymHash_read8(pc + 8) ^ uSeed);
+         pc += 16;
+         uLeft -= 16;
+      }
+
+      /* reads the last 16 characters, which may overlap ones
+         already mixed */
+      uA = SymHash_read8(pc + uLeft - 16);
+      uB = SymHash_read8(pc + uLeft - 8);
+   }
+
+   uA ^= wySecret[1];
+   uB ^= uSeed;
+   SymHash_multiply(&uA, &uB);
+   return (size_t)SymHash_mix(uA ^ wySecret[0] ^ (uint64_t)uLength,
+                              uB ^ wySecret[1]);
+}
+
+size_t SymHash_hash(enum SymHash_Function eFunction, const char *pcKey,
+                    size_t uLength) {
+   /* ensures no null input */
+   assert(pcKey != NULL);
+
+   switch (eFunction) {
+      case SYMHASH_FNV1A:
+         return SymHash_fnv1a(pcKey, uLength);
+      case SYMHASH_WY:
+         return SymHash_wy(pcKey, uLength);
+      case SYMHASH_LEGACY:
+      default:
+         return SymHash_legacy(pcKey, uLength);
+   }
+}
+
+size_t SymHash_hashString(enum SymHash_Function eFunction,
+                          const char *pcKey, size_t *puLength) {
+   const size_t HASH_MULTIPLIER = 65599;
+   size_t u;
+   size_t uHash = 0;
+
+   /* ensures no null input */
+   assert(pcKey != NULL);
+   assert(puLength != NULL);
+
+   if (eFunction != SYMHASH_LEGACY) {
+      *puLength = strlen(pcKey);
+      return SymHash_hash(eFunction, pcKey, *puLength);
+   }
+
+   /* calulates the legacy hash value and the length together */
+   for (u = 0; pcKey[u] != '\0'; u++)
+      uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];
+
+   *puLength = u;
+   return uHash;
+}
+
+const char *SymHash_name(enum SymHash_Function eFunction) {
+   switch (eFunction) {
+      case SYMHASH_LEGACY:
+         return "legacy";
+      case SYMHASH_FNV1A:
+         return "fnv1a";
+      case SYMHASH_WY:
+         return "wyhash";
+      default:
+         return "unknown";
+   }
+}
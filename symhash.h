@@ -0,0 +1,43 @@
+/* Contains the declarations for the hash functions that a SymTable
+   can use to find the bucket of a key. */
+
+/* insures that the declarations are only included once */
+#ifndef SYMHASH_INCLUDED
+#define SYMHASH_INCLUDED
+#include <stddef.h>
+
+/* the available hash functions */
+enum SymHash_Function {
+   /* the multiplicative hash from the assignment specification,
+      which reads one character at a time. It is the default, and
+      testCollisions in testsymtable.c depends on it */
+   SYMHASH_LEGACY,
+
+   /* the 64 bit FNV-1a hash, which reads one character at a time */
+   SYMHASH_FNV1A,
+
+   /* a wyhash style hash, which reads 8 characters at a time and
+      mixes them with full width multiplications */
+   SYMHASH_WY
+};
+
+/* the number of values of enum SymHash_Function */
+enum {SYMHASH_FUNCTION_COUNT = 3};
+
+/* Takes in a hash function, eFunction, a key, pcKey, and its
+   length, uLength. Returns the full width hash code of the first
+   uLength characters of pcKey, which may include '\0'. */
+size_t SymHash_hash(enum SymHash_Function eFunction, const char *pcKey,
+                    size_t uLength);
+
+/* Takes in a hash function, eFunction, and a '\0' terminated key,
+   pcKey. Returns the same hash code as SymHash_hash and stores the
+   length of pcKey in *puLength. The legacy hash finds the length
+   and the hash code in one pass. */
+size_t SymHash_hashString(enum SymHash_Function eFunction,
+                          const char *pcKey, size_t *puLength);
+
+/* Takes in a hash function, eFunction, and returns its name. */
+const char *SymHash_name(enum SymHash_Function eFunction);
+
+#endif
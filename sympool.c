@@ -0,0 +1,296 @@
+/* implements the allocator that a SymTable uses for its bindings */
+
+/* includes libraries*/
+#include <assert.h>
+#include <stdlib.h>
+#include "sympool.h"
+
+/* the number of bytes that every block size is a multiple of. It
+   keeps every block aligned for the pointers and sizes of a
+   binding */
+enum {GRANULE = 16};
+
+/* the number of size classes. Class i holds blocks of
+   (i + 1) * GRANULE bytes, and larger blocks are plain mallocs */
+enum {CLASS_COUNT = 32};
+
+/* the number of bytes that every slab is allocated with. The slabs
+   of a region start with this size and double until they reach
+   REGION_SLAB_SIZE */
+enum {SLAB_SIZE = 4096};
+enum {REGION_SLAB_SIZE = 1 << 20};
+
+/* Each slab starts with a Slab, which links it to the other slabs
+   of its SymPool. Its blocks follow the first GRANULE bytes. A
+   region also puts every large block in a slab of its own. */
+struct Slab {
+   /* The address of the next Slab */
+   struct Slab *psNextSlab;
+};
+
+/* Each released block holds a FreeBlock, which links it to the
+   other released blocks of its size class */
+struct FreeBlock {
+   /* The address of the next released block */
+   struct FreeBlock *psNextBlock;
+};
+
+/* SymPool is a structure that contains the slabs of a SymTable,
+   the part of the newest slab that no block has used yet, and the
+   released blocks of every size class. It also counts the blocks
+   allocated and the ones that reused a released block. */
+struct SymPool {
+   /* the released blocks of every size class */
+   struct FreeBlock *apsFreeBlocks[CLASS_COUNT];
+
+   /* the start and the length of the unused part of the newest
+      slab */
+   char *pcNext;
+   size_t uLeft;
+
+   /* The address of the newest Slab */
+   struct Slab *psFirstSlab;
+
+   /* the number of blocks allocated and the number of those that
+      reused a released block */
+   size_t uAllocations;
+   size_t uReuses;
+
+   /* 1 (TRUE) if the SymPool is a region, whose slabs hold every
+      block, or 0 (FALSE) if large blocks are plain mallocs */
+   int region;
+
+   /* the number of bytes that the next slab is allocated with */
+   size_t uSlabSize;
+};
+
+/* Takes in an int, iRegion, that is 1 (TRUE) for a region. Returns
+   a new SymPool with no slabs, or NULL if insufficient memory is
+   available. */
+static SymPool_T SymPool_create(int iRegion) {
+   SymPool_T oSymPool;
+   /* for loop variable */
+   size_t i;
+
+   oSymPool = (SymPool_T)malloc(sizeof(struct SymPool));
+
+   /* checks to see if malloc failed */
+   if (oSymPool == NULL)
+      return NULL;
+
+   /* starts with no slabs and no released blocks */
+   for (i = 0; i < CLASS_COUNT; i++)
+      oSymPool->apsFreeBlocks[i] = NULL;
+   oSymPool->pcNext = NULL;
+   oSymPool->uLeft = 0;
+   oSymPool->psFirstSlab = NULL;
+   oSymPool->uAllocations = 0;
+   oSymPool->uReuses = 0;
+   oSymPool->region = iRegion;
+   oSymPool->uSlabSize = SLAB_SIZE;
+
+   return oSymPool;
+}
+
+SymPool_T SymPool_new(void) {
+   return SymPool_create(0);
+}
+
+SymPool_T SymPool_newRegion(void) {
+   return SymPool_create(1);
+}
+
+void SymPool_free(SymPool_T oSymPool) {
+   struct Slab *psCurrentSlab;
+   struct Slab *psNextSlab;
+
+   /* ensures no null input */
+   assert(oSymPool != NULL);
+
+   /* frees every slab, and the blocks within them */
+   for (psCurrentSlab = oSymPool->psFirstSlab; psCurrentSlab != NULL;
+        psCurrentSlab = psNextSlab) {
+      psNextSlab = psCurrentSlab->psNextSlab;
+      free(psCurrentSlab);
+   }
+   free(oSymPool);
+}
+
+#ifdef SYMTABLE_NO_POOL
+
+void *SymPool_alloc(SymPool_T oSymPool, size_t uSize) {
+   /* ensures no null input */
+   assert(oSymPool != NULL);
+
+   oSymPool->uAllocations++;
+   return malloc(uSize);
+}
+
+void SymPool_release(SymPool_T oSymPool, void *pvBlock,
+                     size_t uSize) {
+   /* ensures no null input */
+   assert(oSymPool != NULL);
+   assert(pvBlock != NULL);
+
+   (void)uSize;
+   free(pvBlock);
+}
+
+int SymPool_isRegion(SymPool_T oSymPool) {
+   /* ensures no null input */
+   assert(oSymPool != NULL);
+
+   /* every block is a plain malloc that has to be freed */
+   return 0;
+}
+
+#else
+
+/* Takes in a SymPool, oSymPool, whose newest slab is too full for
+   the next block. Releases the rest of the newest slab as one block
+   and starts a new slab. Returns 1 if successful, or 0 if
+   insufficient memory is available. */
+static int SymPool_addSlab(SymPool_T oSymPool) {
+   struct Slab *psNewSlab;
+
+   assert(oSymPool != NULL);
+
+   psNewSlab = (struct Slab *)malloc(oSymPool->uSlabSize);
+
+   /* checks to see if malloc failed */
+   if (psNewSlab == NULL)
+      return 0;
+
+   /* puts the rest of the newest slab into the free list of the
+      largest size class that fits within it */
+   assert(oSymPool->uLeft % GRANULE == 0);
+   assert(oSymPool->uLeft < CLASS_COUNT * GRANULE);
+   if (oSymPool->uLeft > 0)
+      SymPool_release(oSymPool, oSymPool->pcNext, oSymPool->uLeft);
+
+   psNewSlab->psNextSlab = oSymPool->psFirstSlab;
+   oSymPool->psFirstSlab = psNewSlab;
+   oSymPool->pcNext = (char *)psNewSlab + GRANULE;
+   oSymPool->uLeft = oSymPool->uSlabSize - GRANULE;
+
+   /* a region allocates fewer and larger slabs as it fills */
+   if (oSymPool->region && oSymPool->uSlabSize < REGION_SLAB_SIZE)
+      oSymPool->uSlabSize *= 2;
+   return 1;
+}
+
+/* Takes in a region, oSymPool, and the size, uSize, of a block too
+   large for any size class. Returns the block within a new slab of
+   its own, or NULL if insufficient memory is available. */
+static void *SymPool_allocLarge(SymPool_T oSymPool, size_t uSize) {
+   struct Slab *psNewSlab;
+
+   assert(oSymPool != NULL);
+   assert(oSymPool->region);
+
+   psNewSlab = (struct Slab *)malloc(GRANULE + uSize);
+
+   /* checks to see if malloc failed */
+   if (psNewSlab == NULL)
+      return NULL;
+
+   /* links the slab after the newest one, which still has room
+      for more blocks */
+   if (oSymPool->psFirstSlab == NULL) {
+      psNewSlab->psNextSlab = NULL;
+      oSymPool->psFirstSlab = psNewSlab;
+   }
+   else {
+      psNewSlab->psNextSlab = oSymPool->psFirstSlab->psNextSlab;
+      oSymPool->psFirstSlab->psNextSlab = psNewSlab;
+   }
+   return (char *)psNewSlab + GRANULE;
+}
+
+void *SymPool_alloc(SymPool_T oSymPool, size_t uSize) {
+   struct FreeBlock *psBlock;
+   size_t uClass;
+   void *pvBlock;
+
+   /* ensures no null input */
+   assert(oSymPool != NULL);
+   assert(uSize > 0);
+
+   oSymPool->uAllocations++;
+
+   /* large blocks do not belong to any size class */
+   uClass = (uSize - 1) / GRANULE;
+   if (uClass >= CLASS_COUNT) {
+      if (oSymPool->region)
+         pvBlock = SymPool_allocLarge(oSymPool, uSize);
+      else
+         pvBlock = malloc(uSize);
+      if (pvBlock == NULL)
+         oSymPool->uAllocations--;
+      return pvBlock;
+   }
+
+   /* reuses a released block of the same size class if there is
+      one */
+   psBlock = oSymPool->apsFreeBlocks[uClass];
+   if (psBlock != NULL) {
+      oSymPool->apsFreeBlocks[uClass] = psBlock->psNextBlock;
+      oSymPool->uReuses++;
+      return psBlock;
+   }
+
+   /* otherwise carves the block out of the newest slab */
+   uSize = (uClass + 1) * GRANULE;
+   if (oSymPool->uLeft < uSize && !SymPool_addSlab(oSymPool)) {
+      oSymPool->uAllocations--;
+      return NULL;
+   }
+   pvBlock = oSymPool->pcNext;
+   oSymPool->pcNext += uSize;
+   oSymPool->uLeft -= uSize;
+   return pvBlock;
+}
+
+void SymPool_release(SymPool_T oSymPool, void *pvBlock,
+                     size_t uSize) {
+   struct FreeBlock *psBlock = (struct FreeBlock *)pvBlock;
+   size_t uClass;
+
+   /* ensures no null input */
+   assert(oSymPool != NULL);
+   assert(pvBlock != NULL);
+   assert(uSize > 0);
+
+   /* large blocks are plain mallocs, except in a region, which
+      keeps them until it is freed */
+   uClass = (uSize - 1) / GRANULE;
+   if (uClass >= CLASS_COUNT) {
+      if (!oSymPool->region)
+         free(pvBlock);
+      return;
+   }
+
+   /* adds the block to the start of the free list of its class */
+   psBlock->psNextBlock = oSymPool->apsFreeBlocks[uClass];
+   oSymPool->apsFreeBlocks[uClass] = psBlock;
+}
+
+int SymPool_isRegion(SymPool_T oSymPool) {
+   /* ensures no null input */
+   assert(oSymPool != NULL);
+
+   return oSymPool->region;
+}
+
+#endif
+
+void SymPool_getCounts(SymPool_T oSymPool, size_t *puAllocations,
+                       size_t *puReuses) {
+   /* ensures no null input */
+   assert(oSymPool != NULL);
+   assert(puAllocations != NULL);
+   assert(puReuses != NULL);
+
+   *puAllocations = oSymPool->uAllocations;
+   *puReuses = oSymPool->uReuses;
+}
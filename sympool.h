@@ -0,0 +1,55 @@
+/* Contains the declarations for the allocator that a SymTable uses
+   for its bindings. A SymPool_T carves small blocks out of larger
+   slabs and keeps a free list for every size class, so that a block
+   released by one remove is reused by the next put of the same
+   size. A region also puts large blocks in its slabs, so that
+   freeing it releases every block without visiting each one.
+   Compiling with -DSYMTABLE_NO_POOL makes every block a plain
+   malloc, so that leak checkers can see each binding. */
+
+/* insures that the declarations are only included once */
+#ifndef SYMPOOL_INCLUDED
+#define SYMPOOL_INCLUDED
+#include <stddef.h>
+
+/* a SymPool_T owns the slabs that the blocks it allocates are in */
+typedef struct SymPool *SymPool_T;
+
+/* Returns a new SymPool_T with no slabs, or NULL if insufficient
+   memory is available. */
+SymPool_T SymPool_new(void);
+
+/* Returns a new SymPool_T that is a region with no slabs, or NULL
+   if insufficient memory is available. */
+SymPool_T SymPool_newRegion(void);
+
+/* Takes in a SymPool_T, oSymPool, and returns 1 (TRUE) if freeing
+   it frees all of its blocks, or 0 (FALSE) if each block has to be
+   released first. */
+int SymPool_isRegion(SymPool_T oSymPool);
+
+/* Takes in a SymPool_T, oSymPool, and frees it along with all of
+   its slabs. Unless oSymPool is a region, every block of oSymPool
+   must have been released. */
+void SymPool_free(SymPool_T oSymPool);
+
+/* Takes in a SymPool_T, oSymPool, and a size, uSize. Returns a
+   block of at least uSize bytes aligned for any binding, or NULL
+   if insufficient memory is available. */
+void *SymPool_alloc(SymPool_T oSymPool, size_t uSize);
+
+/* Takes in a SymPool_T, oSymPool, a block, pvBlock, that oSymPool
+   allocated, and the size, uSize, that it was allocated with.
+   Makes pvBlock available to the next allocation of its size
+   class. A region keeps a released block that is too large for
+   every size class until the region is freed. */
+void SymPool_release(SymPool_T oSymPool, void *pvBlock, size_t uSize);
+
+/* Takes in a SymPool_T, oSymPool, which will not be modified, and
+   stores the number of blocks it has allocated in *puAllocations
+   and the number of those that reused a released block in
+   *puReuses. */
+void SymPool_getCounts(SymPool_T oSymPool, size_t *puAllocations,
+                       size_t *puReuses);
+
+#endif
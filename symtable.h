@@ -5,6 +5,7 @@
 #ifndef HEADERFILE
 #define HEADERFILE
 #include <stddef.h>
+#include "symhash.h"
 
 /* a SympTable_T store bindings in a last in first out order */
 typedef struct Table *SymTable_T;
@@ -14,6 +15,31 @@ typedef struct Table *SymTable_T;
    This function does not take any value as input. */
 SymTable_T SymTable_new(void);
 
+/* Returns a new SymTable_T that contains no bindings, like
+   SymTable_new, except that its bindings and keys are allocated
+   from large chunks. SymTable_free then releases the chunks
+   without visiting each binding. The storage of a removed binding
+   whose key is longer than about 480 characters is kept until
+   SymTable_free. Returns NULL if insufficient memory is available.
+   Only the linked list and hash table implementations provide this
+   function. */
+SymTable_T SymTable_newRegion(void);
+
+/* Returns a new SymTable_T that contains no bindings, like
+   SymTable_new, except that SymTable_put, SymTable_upsert,
+   SymTable_getOrPut and SymTable_putK store the caller's key
+   pointer instead of a defensive copy, and SymTable_remove and
+   SymTable_free never free keys. Every key put into the table must
+   stay unchanged until its binding is removed or the table is
+   freed, as string literals and keys in a longer-lived arena do.
+   The expectations of testKeyOwnership in testsymtable.c are
+   inverted for such a table: changing the caller's array after
+   SymTable_put changes the key of the binding, which then can no
+   longer be found. SymTable_putN still copies its key. Returns NULL
+   if insufficient memory is available. Only the hash table
+   implementation provides this function. */
+SymTable_T SymTable_newBorrowedKeys(void);
+
 /* Does not return a value, but frees all memory
    occupied by the input oSymTable  */
 void SymTable_free(SymTable_T oSymTable);
@@ -34,6 +60,28 @@ size_t SymTable_getLength(SymTable_T oSymTable);
 int SymTable_put(SymTable_T oSymTable, const char *pcKey,
                  const void *pvValue);
 
+/* Takes in a SymTable_T value, oSymTable, a key, pcKey, and a
+   value, pvValue, as input. Hashes and searches for pcKey only
+   once. If oSymTable does not contain pcKey, a binding of pcKey
+   and pvValue is added and *piInserted is set to 1 (TRUE).
+   Otherwise the value of the binding containing pcKey is replaced
+   by pvValue and *piInserted is set to 0 (FALSE). piInserted can
+   be NULL. Returns the address of the binding's value, which the
+   caller can read or change until the binding is removed. If
+   insufficient memory is available, oSymTable is left unchanged,
+   *piInserted is set to 0 and NULL is returned. Only the linked
+   list and hash table implementations provide this function. */
+void **SymTable_upsert(SymTable_T oSymTable, const char *pcKey,
+                       const void *pvValue, int *piInserted);
+
+/* Takes in a SymTable_T value, oSymTable, a key, pcKey, and a
+   value, pvValue, as input. Behaves like SymTable_upsert except
+   that if oSymTable already contains pcKey, the value of its
+   binding is left unchanged. Only the linked list and hash table
+   implementations provide this function. */
+void **SymTable_getOrPut(SymTable_T oSymTable, const char *pcKey,
+                         const void *pvValue, int *piInserted);
+
 /* Takes in a SymTable_T value, oSymTable, as input which will
    be modified if it contains pcKey which is passed as input.
    If oSymTable is found to contain the pcKey, then the pvValue
@@ -75,4 +123,414 @@ void SymTable_map(SymTable_T oSymTable,
                                    *pvValue, void *pvExtra),
                   const void *pvExtra);
 
+/* Statistics about a SymTable_T, filled in by SymTable_getStats */
+struct SymTable_Stats {
+   /* the number of resizes that have been started */
+   size_t uResizes;
+
+   /* the number of SymTable_put calls that ran while an
+      incremental resize was in progress */
+   size_t uMigrationPuts;
+
+   /* the most bindings moved from one bucket array to another by a
+      single call. This is the worst single-operation cost of
+      resizing: every binding for a stop-the-world resize and a
+      bounded number for an incremental one */
+   size_t uMaxMoved;
+
+   /* the number of bindings allocated, and the number of those
+      that reused the storage of a removed binding instead of
+      calling malloc */
+   size_t uBindingAllocations;
+   size_t uBindingReuses;
+
+   /* the number of key bytes that the bindings share with atoms or
+      borrow from their callers instead of copying. Summed over the
+      tables that share the same atoms, it is the memory that
+      interning saves */
+   size_t uSharedKeyBytes;
+};
+
+/* Takes in a SymTable_T value, oSymTable, and an int, iEnabled.
+   If iEnabled is 1 (TRUE), later resizes of oSymTable keep the old
+   and new bucket arrays side by side and each SymTable_put,
+   SymTable_replace, SymTable_contains, SymTable_get and
+   SymTable_remove call moves a bounded number of buckets until the
+   old array is empty. If iEnabled is 0 (FALSE), the default, each
+   resize moves every binding at once. A resize that is already in
+   progress is not affected. Only the hash table implementation
+   provides this function. */
+void SymTable_setIncrementalResize(SymTable_T oSymTable, int iEnabled);
+
+/* Takes in a SymTable_T value, oSymTable, and a double,
+   dLoadFactor, greater than 0. oSymTable will grow once it holds
+   more than dLoadFactor bindings per bucket, and shrink once it
+   holds fewer than a quarter of that, so a smaller dLoadFactor
+   trades memory for shorter chains. The default is 1.0. The new
+   limits are applied by the following SymTable_put and
+   SymTable_remove calls. Only the hash table implementation
+   provides this function. */
+void SymTable_setLoadFactor(SymTable_T oSymTable, double dLoadFactor);
+
+/* Takes in a SymTable_T value, oSymTable, and a hash function,
+   eFunction. Every key of oSymTable is rehashed with eFunction,
+   which is then used for all of the keys that follow. The default
+   is SYMHASH_LEGACY. Only the hash table implementation provides
+   this function. */
+void SymTable_setHashFunction(SymTable_T oSymTable,
+                              enum SymHash_Function eFunction);
+
+/* Takes in a SymTable_T value, oSymTable, whose bindings will not
+   be changed, and an array, auCounts, of uCountsLength counts.
+   Sets auCounts[i] to the number of buckets of oSymTable that hold
+   i bindings, except that auCounts[uCountsLength - 1] counts every
+   bucket holding at least uCountsLength - 1 bindings. An
+   incremental resize in progress is finished first. Only the hash
+   table implementation provides this function. */
+void SymTable_getChainLengths(SymTable_T oSymTable, size_t auCounts[],
+                              size_t uCountsLength);
+
+/* Takes in a SymTable_T value, oSymTable, which will not be
+   modified, and stores the statistics collected about oSymTable
+   since it was created in *psStats. The linked list implementation
+   only counts binding allocations and sets the other statistics to
+   0. The concurrent hash table implementation counts resizes, the
+   bindings moved by the largest one and binding allocations, over
+   all of its shards, and sets the other statistics to 0. Only the
+   linked list, hash table and concurrent hash table implementations
+   provide this function. */
+void SymTable_getStats(SymTable_T oSymTable,
+                       struct SymTable_Stats *psStats);
+
+/* a SymAtom_T is the interned copy of a key, which is shared by
+   every SymTable_T that the key is put into with SymTable_putAtom */
+typedef struct SymAtom *SymAtom_T;
+
+/* Takes in a key, pcKey, and returns its SymAtom_T. Interning the
+   same key again returns the same SymAtom_T, which stays valid
+   until the program ends. Every atom is kept in one table that the
+   whole program shares and that no lock guards, so SymTable_intern
+   is not thread-safe: only one thread at a time may call it, even
+   in a program that also uses the concurrent implementation.
+   Returns NULL if insufficient memory is available. Only the hash
+   table implementation provides this function. */
+SymAtom_T SymTable_intern(const char *pcKey);
+
+/* Takes in a SymAtom_T, oAtom, and returns its key. Only the hash
+   table implementation provides this function. */
+const char *SymTable_atomKey(SymAtom_T oAtom);
+
+/* Takes in a SymTable_T value, oSymTable, a SymAtom_T, oAtom, and a
+   value, pvValue. Behaves like SymTable_put with the key of oAtom,
+   except that the new binding shares the key of oAtom instead of
+   copying it, and the cached hash code of oAtom is used. Only the
+   hash table implementation provides this function. */
+int SymTable_putAtom(SymTable_T oSymTable, SymAtom_T oAtom,
+                     const void *pvValue);
+
+/* Takes in a SymTable_T value, oSymTable, and a SymAtom_T, oAtom.
+   Behaves like SymTable_get with the key of oAtom, except that the
+   cached hash code of oAtom is used and a binding put with
+   SymTable_putAtom is recognized by the address of its key alone,
+   unless oSymTable was made by SymTable_newBorrowedKeys. Only the
+   hash table implementation provides this function. */
+void *SymTable_getAtom(SymTable_T oSymTable, SymAtom_T oAtom);
+
+/* A SymTable_Key is a key whose length and full hash code have
+   been computed once, so that it can be looked up in many tables
+   without hashing it again. It does not copy the key, which has to
+   stay unchanged while the SymTable_Key is in use. */
+typedef struct SymTable_Key {
+   /* the key */
+   const char *pcKey;
+
+   /* the length of the key */
+   size_t uLength;
+
+   /* the full hash code of the key, before it is reduced to a
+      bucket, and the hash function that computed it */
+   size_t uHash;
+   enum SymHash_Function eFunction;
+} SymTable_Key;
+
+/* Takes in a key, pcKey, and returns its SymTable_Key, hashed with
+   the default hash function. A table that uses another hash
+   function hashes the key again. Only the hash table
+   implementation provides this function. */
+SymTable_Key SymTable_makeKey(const char *pcKey);
+
+/* Takes in a SymTable_T value, oSymTable, a SymTable_Key, sKey, and
+   a value, pvValue. Behaves like SymTable_put with the key of sKey
+   without hashing it again. The key is still copied. Only the hash
+   table implementation provides this function. */
+int SymTable_putK(SymTable_T oSymTable, SymTable_Key sKey,
+                  const void *pvValue);
+
+/* Takes in a SymTable_T value, oSymTable, and a SymTable_Key, sKey.
+   Behaves like SymTable_contains with the key of sKey without
+   hashing it again. Only the hash table implementation provides
+   this function. */
+int SymTable_containsK(SymTable_T oSymTable, SymTable_Key sKey);
+
+/* Takes in a SymTable_T value, oSymTable, and a SymTable_Key, sKey.
+   Behaves like SymTable_get with the key of sKey without hashing
+   it again. sKey stays valid when oSymTable resizes, because the
+   bucket is found from its full hash code every time. Only the
+   hash table implementation provides this function. */
+void *SymTable_getK(SymTable_T oSymTable, SymTable_Key sKey);
+
+/* Takes in a SymTable_T value, oSymTable, and a SymTable_Key, sKey.
+   Behaves like SymTable_remove with the key of sKey without
+   hashing it again. Only the hash table implementation provides
+   this function. */
+void *SymTable_removeK(SymTable_T oSymTable, SymTable_Key sKey);
+
+/* Takes in a SymTable_T value, oSymTable, a key, pcKey, its length,
+   uLength, and a value, pvValue. Behaves like SymTable_put with the
+   key made of exactly the first uLength characters of pcKey, which
+   need not be followed by '\0' and may include '\0'. The copy of
+   the key is followed by '\0', so SymTable_map passes it to
+   *pfApply as a string that ends at its first '\0'. Only the hash
+   table implementation provides this function. */
+int SymTable_putN(SymTable_T oSymTable, const char *pcKey,
+                  size_t uLength, const void *pvValue);
+
+/* Takes in a SymTable_T value, oSymTable, a key, pcKey, its length,
+   uLength, and a value, pvValue. Behaves like SymTable_replace with
+   the key made of exactly the first uLength characters of pcKey.
+   Only the hash table implementation provides this function. */
+void *SymTable_replaceN(SymTable_T oSymTable, const char *pcKey,
+                        size_t uLength, const void *pvValue);
+
+/* Takes in a SymTable_T value, oSymTable, a key, pcKey, and its
+   length, uLength. Behaves like SymTable_contains with the key made
+   of exactly the first uLength characters of pcKey. Only the hash
+   table implementation provides this function. */
+int SymTable_containsN(SymTable_T oSymTable, const char *pcKey,
+                       size_t uLength);
+
+/* Takes in a SymTable_T value, oSymTable, a key, pcKey, and its
+   length, uLength. Behaves like SymTable_get with the key made of
+   exactly the first uLength characters of pcKey. Only the hash
+   table implementation provides this function. */
+void *SymTable_getN(SymTable_T oSymTable, const char *pcKey,
+                    size_t uLength);
+
+/* Takes in a SymTable_T value, oSymTable, a key, pcKey, and its
+   length, uLength. Behaves like SymTable_remove with the key made
+   of exactly the first uLength characters of pcKey. Only the hash
+   table implementation provides this function. */
+void *SymTable_removeN(SymTable_T oSymTable, const char *pcKey,
+                       size_t uLength);
+
+/* Takes in a SymTable_T value, oSymTable, an array of uCount keys,
+   apcKeys, an array of uCount values, apvValues, and an array of
+   uCount ints, aiResults, which can be NULL. Puts each key with the
+   value at the same index as SymTable_put does, in order, and sets
+   the int at the same index of aiResults to what SymTable_put would
+   have returned. oSymTable is resized at most once beforehand, to
+   fit all of the keys, and keys are hashed a chunk at a time so
+   that their buckets can be prefetched before they are linked.
+   Returns the number of bindings added. Only the hash table
+   implementation provides this function. */
+size_t SymTable_putBatch(SymTable_T oSymTable,
+                         const char *const apcKeys[],
+                         const void *const apvValues[],
+                         size_t uCount, int aiResults[]);
+
+/* Takes in a SymTable_T value, oSymTable, whose bindings will not
+   be changed, an array of uCount keys, apcKeys, and an array of
+   uCount values, apvValues. Sets each element of apvValues to what
+   SymTable_get would return for the key at the same index. The
+   chains of many keys are searched side by side, one binding per
+   key at a time, so that their cache misses overlap. Returns the
+   number of keys found. Only the hash table implementation
+   provides this function. */
+size_t SymTable_getMany(SymTable_T oSymTable,
+                        const char *const apcKeys[], size_t uCount,
+                        void *apvValues[]);
+
+/* Takes in the number of stripes, uStripeCount, which is at least
+   1. Returns a new SymTable_T that contains no bindings and that
+   many threads can use at once, or NULL if insufficient memory is
+   available. Its buckets are divided among uStripeCount
+   reader/writer locks, so that SymTable_get and SymTable_contains
+   on any keys, and the other functions on keys of different
+   stripes, run in parallel. A resize locks every stripe, in order,
+   and only one thread resizes at a time. SymTable_map holds every
+   stripe shared while it calls *pfApply, so *pfApply must not call
+   any function on the same table: SymTable_put, SymTable_replace
+   and SymTable_remove would wait forever for a stripe that the map
+   holds, and SymTable_get can too once a writer waits for that
+   stripe. SymTable_new returns such a table with 64 stripes.
+   SymTable_free must only be called once no other thread uses the
+   table. Only the concurrent hash table implementation provides
+   this function. */
+SymTable_T SymTable_newConcurrent(size_t uStripeCount);
+
+/* Takes in the number of stripes, uStripeCount, which is at least
+   1. Returns a new SymTable_T like SymTable_newConcurrent, except
+   that SymTable_get and SymTable_contains take no lock. Writers
+   publish each binding and bucket array with an atomic store once
+   it is fully written, a resize copies the bindings instead of
+   relinking the chains that readers may be walking, and a removed
+   binding or replaced bucket array is freed only once every read
+   that started before it was unlinked has finished. Each thread
+   that reads the table keeps a small record that announces when
+   its reads start, and each table uses one thread specific data
+   key, so a process can only have as many such tables at once as
+   it has free keys. Returns NULL if insufficient memory is
+   available. Only the concurrent hash table implementation
+   provides this function. */
+SymTable_T SymTable_newLockFreeReads(size_t uStripeCount);
+
+/* Takes in a number of shards, uShardCount, and a number of
+   stripes, uStripeCount, which are both at least 1. Returns a new
+   SymTable_T like SymTable_newConcurrent, except that its bindings
+   are divided among uShardCount inner tables, rounded up to a power
+   of two of at most 65536, by the high bits of the hash codes of
+   their keys. Each shard has its own buckets, uStripeCount stripes
+   and statistics, and resizes on its own, so that a resize moves
+   only the bindings of one shard and stalls only the threads using
+   that shard. SymTable_map visits every shard in turn, holding the
+   stripes of one shard at a time, and SymTable_getLength sums the
+   lengths of the shards. Returns NULL if insufficient memory is
+   available. Only the concurrent hash table implementation provides
+   this function. */
+SymTable_T SymTable_newSharded(size_t uShardCount,
+                               size_t uStripeCount);
+
+/* Takes in a SymTable_T value, oSymTable, an array, asStats, and
+   its length, uCount. Stores the statistics of each of the first
+   uCount shards of oSymTable in the element of asStats with the
+   same index, as SymTable_getStats does for the whole table, and
+   returns the number of shards. A table not made by
+   SymTable_newSharded has one shard. Only the concurrent hash table
+   implementation provides this function. */
+size_t SymTable_getShardStats(SymTable_T oSymTable,
+                              struct SymTable_Stats asStats[],
+                              size_t uCount);
+
+/* Takes in a SymTable_T value, oSymTable, whose bindings will not
+   be changed until this function returns, a function, *pfApply, a
+   value, pvExtra, and a number of threads, uThreads, which is the
+   number of online processors if it is 0. Behaves like SymTable_map,
+   except that the buckets are divided into chunks that uThreads
+   threads, including the calling thread, take one at a time until
+   none are left, so that *pfApply is called for different bindings
+   at the same time and in no particular order. *pfApply must not
+   change oSymTable, and must be safe to call from several threads
+   with the same pvExtra. Only the hash table implementation provides
+   this function. */
+void SymTable_mapParallel(SymTable_T oSymTable,
+                          void (*pfApply) (const char *pcKey,
+                                           void *pvValue,
+                                           void *pvExtra),
+                          const void *pvExtra, size_t uThreads);
+
+/* Takes in a SymTable_T value, oSymTable, a function, *pfApply, two
+   functions, *pfBegin and *pfEnd, that can be NULL, a value,
+   pvExtra, and a number of threads, uThreads. Behaves like
+   SymTable_mapParallel, except that each thread passes its own
+   value, pvLocal, to *pfApply, so that the threads do not share a
+   value. Before any binding is visited, the calling thread makes
+   the pvLocal of each thread with (*pfBegin)(pvExtra), or uses
+   pvExtra itself if pfBegin is NULL. Once every binding has been
+   visited, the calling thread calls (*pfEnd)(pvLocal, pvExtra) for
+   each thread in order, to combine the results of the threads into
+   pvExtra and release pvLocal. Only the hash table implementation
+   provides this function. */
+void SymTable_mapReduce(SymTable_T oSymTable,
+                        void (*pfApply) (const char *pcKey,
+                                         void *pvValue,
+                                         void *pvLocal),
+                        void *(*pfBegin) (void *pvExtra),
+                        void (*pfEnd) (void *pvLocal, void *pvExtra),
+                        void *pvExtra, size_t uThreads);
+
+/* Takes in a SymTable_T value, oSymTable, a number of bindings,
+   uThreshold, and a number of threads, uThreads, which is the
+   number of online processors if it is 0. A later resize that moves
+   every binding at once while oSymTable holds at least uThreshold
+   bindings divides the old buckets between up to uThreads threads,
+   including the calling thread. Each thread stages the bindings it
+   takes by the part of the new buckets they belong in, and the
+   threads then link the staged bindings of different parts into
+   their buckets, so that no lock is taken. Small bucket arrays use
+   fewer threads, and the calling thread moves every binding alone
+   if only one thread would. The default uThreshold is 1048576 and
+   the default uThreads is 0, and a uThreshold of SIZE_MAX never
+   moves bindings with several threads. Only the hash table
+   implementation provides this function. */
+void SymTable_setParallelResize(SymTable_T oSymTable,
+                                size_t uThreshold, size_t uThreads);
+
+/* A SymTable_Iter holds the position of a scan of the bindings of
+   a SymTable_T. The caller declares it, usually as a local
+   variable, and passes its address to SymTable_iterBegin and
+   SymTable_iterNext. Its fields belong to the implementation. */
+struct SymTable_Iter {
+   /* the next bucket to scan */
+   size_t uBucket;
+
+   /* the next binding to return, or NULL if there is none before
+      the next bucket */
+   void *pvBinding;
+};
+
+/* Takes in a SymTable_T value, oSymTable, and the address of a
+   SymTable_Iter, psIter. Sets *psIter to the start of a scan that
+   SymTable_iterNext uses to return the bindings of oSymTable one
+   at a time. A hash table first finishes any resize that is in
+   progress, so that searching it during the scan never moves a
+   binding. Only the linked list and hash table implementations
+   provide this function. */
+void SymTable_iterBegin(SymTable_T oSymTable,
+                        struct SymTable_Iter *psIter);
+
+/* Takes in a SymTable_T value, oSymTable, the address of a
+   SymTable_Iter, psIter, that SymTable_iterBegin set to a scan of
+   oSymTable, and two addresses, ppcKey and ppvValue, that can be
+   NULL. If the scan has a binding left, stores its key in *ppcKey
+   and its value in *ppvValue, moves *psIter past it and returns
+   1 (TRUE). Otherwise returns 0 (FALSE). Each binding is returned
+   once, in the order that SymTable_map visits them. The scan can
+   be stopped at any binding and continued later, as long as no
+   binding is added to or removed from oSymTable in the meantime.
+   Searching oSymTable and replacing values is allowed. Only the
+   linked list and hash table implementations provide this
+   function. */
+int SymTable_iterNext(SymTable_T oSymTable,
+                      struct SymTable_Iter *psIter,
+                      const char **ppcKey, void **ppvValue);
+
+/* Takes in a SymTable_T value, oSymTable, two keys, pcLow and
+   pcHigh, a function, *pfApply, and a value, pvExtra. Applies
+   *pfApply to each binding whose key is greater than or equal to
+   pcLow and less than pcHigh, in increasing strcmp order of the
+   keys, passing pvExtra as an extra argument. A NULL pcLow has no
+   lower bound, and a NULL pcHigh has no upper bound. Takes time
+   proportional to the logarithm of the number of bindings plus the
+   number of bindings visited. Only the B+-tree implementation
+   provides this function. */
+void SymTable_mapRange(SymTable_T oSymTable, const char *pcLow,
+                       const char *pcHigh,
+                       void (*pfApply) (const char *pcKey,
+                                        void *pvValue,
+                                        void *pvExtra),
+                       const void *pvExtra);
+
+/* Takes in a SymTable_T value, oSymTable, a key prefix, pcPrefix,
+   a function, *pfApply, and a value, pvExtra. Applies *pfApply to
+   each binding whose key starts with pcPrefix, in increasing
+   strcmp order of the keys, passing pvExtra as an extra argument.
+   Takes time proportional to the logarithm of the number of
+   bindings plus the number of bindings visited. Only the B+-tree
+   implementation provides this function. */
+void SymTable_mapPrefix(SymTable_T oSymTable, const char *pcPrefix,
+                        void (*pfApply) (const char *pcKey,
+                                         void *pvValue,
+                                         void *pvExtra),
+                        const void *pvExtra);
+
 #endif
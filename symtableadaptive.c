@@ -0,0 +1,446 @@
+/* implements the SymTable adaptive version, which keeps a few
+   bindings in a small array and switches to a hash table once it
+   holds more */
+
+/* includes libraries*/
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "symtable.h"
+
+/* the most bindings that a Table keeps in its small array. A
+   SymTable_put that would add one more moves every binding into a
+   hash table */
+enum {SMALL_CAPACITY = 8};
+
+/* a hash table moves its bindings back into the small array once a
+   SymTable_remove leaves it with DEMOTE_COUNT bindings. It is well
+   below SMALL_CAPACITY, so that a Table that keeps gaining and
+   losing a binding near the limit does not switch every time */
+enum {DEMOTE_COUNT = SMALL_CAPACITY / 2};
+
+/* the number of buckets that a hash table starts with and never
+   shrinks below. The bucket count is always a power of two, so
+   that the bucket of a hash code is found with a mask */
+enum {MIN_BUCKETS = 4 * SMALL_CAPACITY};
+
+/* the hash function of the keys. The mask keeps only the low bits
+   of a hash code, which every character of a key has to change.
+   The legacy hash does not do that: its multiplier is odd, so keys
+   whose characters differ by a multiple of the bucket count, such
+   as "Jeter" and "jeter", share a bucket. FNV-1a mixes each
+   character into every bit */
+#define SYMTABLE_HASH SYMHASH_FNV1A
+
+/* Each item is stored in a Binding. The same Binding is used in
+   the small array and in the hash table, so that switching between
+   them only moves pointers */
+struct Binding {
+   /* stores the value of the binding */
+   void *pvValue;
+
+   /* The address of the next Binding in the bucket. Unused while
+      the Binding is in the small array */
+   struct Binding *psNextBinding;
+
+   /* stores the full hash code of the key. It is only computed once
+      the Binding moves into a hash table */
+   size_t uHash;
+
+   /* stores the defensive copy of the key of the binding, which is
+      allocated together with the binding */
+   char acKey[];
+};
+
+/* Table is a structure that contains either a small array of up to
+   SMALL_CAPACITY Bindings or the buckets of a hash table. It also
+   stores the number of elements contained within the Table */
+struct Table {
+   /* The number of elements contained within
+      the Table */
+   size_t tableInputs;
+
+   /* the buckets of the hash table, or NULL while the bindings are
+      in apsSmall */
+   struct Binding **buckets;
+
+   /* the number of buckets minus one */
+   size_t bucketMask;
+
+   /* the bindings while the Table is small, in no particular order.
+      The first tableInputs elements are used */
+   struct Binding *apsSmall[SMALL_CAPACITY];
+};
+
+/* Takes in a key, pcKey. Returns the full hash code of pcKey. */
+static size_t SymTable_hash(const char *pcKey) {
+   size_t uLength;
+
+   assert(pcKey != NULL);
+
+   return SymHash_hashString(SYMTABLE_HASH, pcKey, &uLength);
+}
+
+/* Takes in a Table, oSymTable, and a key, pcKey. Returns the
+   address of the link that points to the binding whose key is
+   pcKey, or NULL if oSymTable does not contain pcKey. While
+   oSymTable is small the link is an element of its small array. */
+static struct Binding **SymTable_find(SymTable_T oSymTable,
+                                      const char *pcKey) {
+   struct Binding **ppsLink;
+   size_t uHash;
+   /* for loop variable */
+   size_t i;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* scans the small array, comparing the first characters before
+      calling strcmp */
+   if (oSymTable->buckets == NULL) {
+      for (i = 0; i < oSymTable->tableInputs; i++)
+         if (oSymTable->apsSmall[i]->acKey[0] == pcKey[0]
+             && strcmp(oSymTable->apsSmall[i]->acKey, pcKey) == 0)
+            return &oSymTable->apsSmall[i];
+      return NULL;
+   }
+
+   /* searches the bucket of pcKey, comparing hash codes before
+      keys */
+   uHash = SymTable_hash(pcKey);
+   for (ppsLink = &oSymTable->buckets[uHash & oSymTable->bucketMask];
+        *ppsLink != NULL;
+        ppsLink = &(*ppsLink)->psNextBinding)
+      if ((*ppsLink)->uHash == uHash
+          && strcmp((*ppsLink)->acKey, pcKey) == 0)
+         return ppsLink;
+   return NULL;
+}
+
+/* Takes in a Table, oSymTable, whose bindings are in a hash table,
+   and a number of buckets, uCount, that is a power of two. Moves
+   every binding into a new bucket array of uCount buckets. Returns
+   1 (TRUE) if successful, or 0 (FALSE), leaving oSymTable
+   unchanged, if insufficient memory is available. */
+static int SymTable_rehash(SymTable_T oSymTable, size_t uCount) {
+   struct Binding **ppsBuckets;
+   struct Binding *psCurrentBinding;
+   struct Binding *psNextBinding;
+   size_t uHash;
+   /* for loop variable */
+   size_t i;
+
+   assert(oSymTable != NULL);
+   assert(oSymTable->buckets != NULL);
+
+   ppsBuckets = (struct Binding**)
+      calloc(uCount, sizeof(struct Binding*));
+   if (ppsBuckets == NULL)
+      return 0;
+
+   for (i = 0; i <= oSymTable->bucketMask; i++)
+      for (psCurrentBinding = oSymTable->buckets[i];
+           psCurrentBinding != NULL;
+           psCurrentBinding = psNextBinding) {
+         psNextBinding = psCurrentBinding->psNextBinding;
+         uHash = psCurrentBinding->uHash & (uCount - 1);
+         psCurrentBinding->psNextBinding = ppsBuckets[uHash];
+         ppsBuckets[uHash] = psCurrentBinding;
+      }
+
+   free(oSymTable->buckets);
+   oSymTable->buckets = ppsBuckets;
+   oSymTable->bucketMask = uCount - 1;
+   return 1;
+}
+
+/* Takes in a Table, oSymTable, whose small array is full. Moves
+   every binding into a hash table of MIN_BUCKETS buckets, hashing
+   each key for the first time. Returns 1 (TRUE) if successful, or
+   0 (FALSE), leaving oSymTable unchanged, if insufficient memory
+   is available. */
+static int SymTable_promote(SymTable_T oSymTable) {
+   struct Binding *psBinding;
+   size_t uHash;
+   /* for loop variable */
+   size_t i;
+
+   assert(oSymTable != NULL);
+   assert(oSymTable->buckets == NULL);
+
+   oSymTable->buckets = (struct Binding**)
+      calloc(MIN_BUCKETS, sizeof(struct Binding*));
+   if (oSymTable->buckets == NULL)
+      return 0;
+   oSymTable->bucketMask = MIN_BUCKETS - 1;
+
+   for (i = 0; i < oSymTable->tableInputs; i++) {
+      psBinding = oSymTable->apsSmall[i];
+      psBinding->uHash = SymTable_hash(psBinding->acKey);
+      uHash = psBinding->uHash & oSymTable->bucketMask;
+      psBinding->psNextBinding = oSymTable->buckets[uHash];
+      oSymTable->buckets[uHash] = psBinding;
+   }
+   return 1;
+}
+
+/* Takes in a Table, oSymTable, whose hash table holds no more than
+   SMALL_CAPACITY bindings. Moves every binding into the small
+   array and frees the buckets. */
+static void SymTable_demote(SymTable_T oSymTable) {
+   struct Binding *psCurrentBinding;
+   size_t uCount = 0;
+   /* for loop variable */
+   size_t i;
+
+   assert(oSymTable != NULL);
+   assert(oSymTable->buckets != NULL);
+   assert(oSymTable->tableInputs <= SMALL_CAPACITY);
+
+   for (i = 0; i <= oSymTable->bucketMask; i++)
+      for (psCurrentBinding = oSymTable->buckets[i];
+           psCurrentBinding != NULL;
+           psCurrentBinding = psCurrentBinding->psNextBinding)
+         oSymTable->apsSmall[uCount++] = psCurrentBinding;
+
+   free(oSymTable->buckets);
+   oSymTable->buckets = NULL;
+   oSymTable->bucketMask = 0;
+}
+
+SymTable_T SymTable_new(void){
+   SymTable_T oSymTable;
+
+   /* intilizes the size of oSymTable to be the same size as
+      the Table struct */
+   oSymTable = (SymTable_T)malloc(sizeof(struct Table));
+
+   /* checks to see if malloc failed */
+   if (oSymTable == NULL)
+      return NULL;
+
+   /* sets the number of inputs to be 0 intially representing
+      an empty SymTable_T, which starts small */
+   oSymTable->tableInputs = 0;
+   oSymTable->buckets = NULL;
+   oSymTable->bucketMask = 0;
+
+   return oSymTable;
+}
+
+void SymTable_free(SymTable_T oSymTable){
+   struct Binding *psCurrentBinding;
+   struct Binding *psNextBinding;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* frees every binding, and the buckets of a hash table */
+   if (oSymTable->buckets == NULL)
+      for (i = 0; i < oSymTable->tableInputs; i++)
+         free(oSymTable->apsSmall[i]);
+   else {
+      for (i = 0; i <= oSymTable->bucketMask; i++)
+         for (psCurrentBinding = oSymTable->buckets[i];
+              psCurrentBinding != NULL;
+              psCurrentBinding = psNextBinding) {
+            psNextBinding = psCurrentBinding->psNextBinding;
+            free(psCurrentBinding);
+         }
+      free(oSymTable->buckets);
+   }
+
+   /* frees the memory created for the oSymTable structure */
+   free(oSymTable);
+}
+
+size_t SymTable_getLength(SymTable_T oSymTable){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* returns the number of inputs wihtin oSymTable */
+   return oSymTable->tableInputs;
+}
+
+int SymTable_put(SymTable_T oSymTable, const char *pcKey,
+                 const void *pvValue) {
+   struct Binding *psNewBinding;
+   size_t uLength;
+   size_t uHash;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* checks if oSymTable already contains pcKey */
+   if (SymTable_find(oSymTable, pcKey) != NULL)
+      return 0;
+
+   /* switches to a hash table once the small array is full */
+   if (oSymTable->buckets == NULL
+       && oSymTable->tableInputs == SMALL_CAPACITY
+       && !SymTable_promote(oSymTable))
+      return 0;
+
+   /* allocates memory for the new binding and the defensive copy
+      of its key */
+   uLength = strlen(pcKey);
+   psNewBinding = (struct Binding*)
+      malloc(sizeof(struct Binding) + uLength + 1);
+
+   /* checks to see if malloc failed */
+   if (psNewBinding == NULL)
+      /* returns 0 representing that their was
+         insufficeint memory */
+      return 0;
+
+   memcpy(psNewBinding->acKey, pcKey, uLength + 1);
+   psNewBinding->pvValue = (void*)pvValue;
+
+   /* adds the binding to the end of the small array, or to the
+      start of its bucket */
+   if (oSymTable->buckets == NULL)
+      oSymTable->apsSmall[oSymTable->tableInputs] = psNewBinding;
+   else {
+      psNewBinding->uHash = SymTable_hash(pcKey);
+      uHash = psNewBinding->uHash & oSymTable->bucketMask;
+      psNewBinding->psNextBinding = oSymTable->buckets[uHash];
+      oSymTable->buckets[uHash] = psNewBinding;
+   }
+
+   /* increments the number of inputs stored in oSymTable */
+   oSymTable->tableInputs++;
+
+   /* doubles the buckets once there are more bindings than
+      buckets. If that fails the chains are just longer */
+   if (oSymTable->buckets != NULL
+       && oSymTable->tableInputs > oSymTable->bucketMask + 1
+       && oSymTable->bucketMask < (size_t)-1 / 2
+          / sizeof(struct Binding*))
+      SymTable_rehash(oSymTable, 2 * (oSymTable->bucketMask + 1));
+
+   return 1;
+}
+
+void *SymTable_replace(SymTable_T oSymTable, const char *pcKey,
+                       const void *pvValue){
+   struct Binding **ppsLink;
+   void *pvValueSave;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   ppsLink = SymTable_find(oSymTable, pcKey);
+   if (ppsLink == NULL)
+      return NULL;
+
+   /* replaces the binding's value with pvValue */
+   pvValueSave = (*ppsLink)->pvValue;
+   (*ppsLink)->pvValue = (void*)pvValue;
+
+   /* returns the old pvValue */
+   return pvValueSave;
+}
+
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   return SymTable_find(oSymTable, pcKey) != NULL;
+}
+
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey){
+   struct Binding **ppsLink;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   ppsLink = SymTable_find(oSymTable, pcKey);
+   if (ppsLink == NULL)
+      /* returns NULL representing that no such binding exists*/
+      return NULL;
+
+   return (*ppsLink)->pvValue;
+}
+
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey){
+   struct Binding **ppsLink;
+   struct Binding *psBinding;
+   void *bindingValue;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   ppsLink = SymTable_find(oSymTable, pcKey);
+   if (ppsLink == NULL)
+      return NULL;
+
+   /* unlinks the binding, filling its place in the small array
+      with the last binding */
+   psBinding = *ppsLink;
+   if (oSymTable->buckets == NULL)
+      *ppsLink = oSymTable->apsSmall[oSymTable->tableInputs - 1];
+   else
+      *ppsLink = psBinding->psNextBinding;
+
+   /* stores the removed bindings value and frees the binding
+      together with its key */
+   bindingValue = psBinding->pvValue;
+   free(psBinding);
+
+   /* decrements the number of inputs within oSymTable */
+   oSymTable->tableInputs--;
+
+   /* switches back to the small array after most of the bindings
+      have been removed, and otherwise halves the buckets once
+      fewer than a quarter of them are used. If halving fails the
+      buckets are just sparser */
+   if (oSymTable->buckets != NULL) {
+      if (oSymTable->tableInputs <= DEMOTE_COUNT)
+         SymTable_demote(oSymTable);
+      else if (oSymTable->bucketMask + 1 > MIN_BUCKETS
+               && oSymTable->tableInputs
+                  < (oSymTable->bucketMask + 1) / 4)
+         SymTable_rehash(oSymTable, (oSymTable->bucketMask + 1) / 2);
+   }
+
+   return bindingValue;
+}
+
+void SymTable_map(SymTable_T oSymTable,
+                  void (*pfApply) (const char *pcKey, void
+                                   *pvValue, void *pvExtra),
+                  const void *pvExtra){
+   struct Binding *psCurrentBinding;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input where unexpected.
+      pvExtra can be NULL */
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   /* applies function *pfApply to each binding in oSymtable
+      passing pvExtra as an extra parameter*/
+   if (oSymTable->buckets == NULL)
+      for (i = 0; i < oSymTable->tableInputs; i++)
+         (*pfApply)(oSymTable->apsSmall[i]->acKey,
+                    oSymTable->apsSmall[i]->pvValue,
+                    (void*)pvExtra);
+   else
+      for (i = 0; i <= oSymTable->bucketMask; i++)
+         for (psCurrentBinding = oSymTable->buckets[i];
+              psCurrentBinding != NULL;
+              psCurrentBinding = psCurrentBinding->psNextBinding)
+            (*pfApply)(psCurrentBinding->acKey,
+                       psCurrentBinding->pvValue,
+                       (void*)pvExtra);
+}
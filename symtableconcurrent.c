@@ -0,0 +1,1167 @@
+/* implements the SymTable thread safe Hash Table version */
+
+/* exposes the POSIX threads and sched_yield under -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* includes libraries*/
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "symtable.h"
+
+/* the number of stripes that a SymTable_new table has. Every
+   bucket belongs to one stripe, and operations on buckets of
+   different stripes run in parallel */
+enum {DEFAULT_STRIPE_COUNT = 64};
+
+/* the most shards a table can have. The shard of a key is chosen
+   by the high bits of its hash code, and the bits below them
+   choose its bucket */
+enum {MAX_SHARD_BITS = 16};
+
+/* the log base 2 of the number of buckets a new Table starts
+   with. The number of buckets is always a power of two so that a
+   bucket can be found with a shift instead of a division */
+enum {INITIAL_BUCKET_BITS = 9};
+
+/* a Table shrinks once it holds fewer than
+   1 / SHRINK_DIVISOR as many bindings as buckets */
+enum {SHRINK_DIVISOR = 4};
+
+/* the number of bytes that each stripe and reader is padded with,
+   so that two of them never share a cache line */
+enum {CACHE_LINE_SIZE = 64};
+
+/* the number of removed bindings a stripe keeps before it tries to
+   free the ones that no reader can still be using */
+enum {RETIRE_BATCH = 64};
+
+/* reads and writes a field that other threads read without holding
+   its lock */
+#define SYMTABLE_LOAD(pv) __atomic_load_n(pv, __ATOMIC_RELAXED)
+#define SYMTABLE_STORE(pv, v) __atomic_store_n(pv, v, __ATOMIC_RELAXED)
+
+/* reads a link that a writer may be changing, and publishes a link
+   to a binding or bucket array that has been fully written */
+#define SYMTABLE_ACQUIRE(pv) __atomic_load_n(pv, __ATOMIC_ACQUIRE)
+#define SYMTABLE_PUBLISH(pv, v) \
+   __atomic_store_n(pv, v, __ATOMIC_RELEASE)
+
+/* orders the stores before it ahead of the loads after it, which
+   is what lets an epoch stop a writer from freeing a binding that
+   a reader has found */
+#define SYMTABLE_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/* Each item is stored in a Binding.
+   Bindings are linked to form a Table*/
+struct Binding {
+   /* stores the value of the binding */
+   void *pvValue;
+
+   /* The address of the next Binding*/
+   struct Binding *psNextBinding;
+
+   /* stores the full hash code of the key, so that resizing never
+      rehashes keys and lookups compare it before the keys */
+   size_t uHash;
+
+   /* stores the length of the key */
+   size_t uKeyLength;
+
+   /* stores the defensive copy of the key of the binding */
+   char acKey[];
+};
+
+/* Buckets is a bucket array together with its size, so that a
+   reader that loads one pointer to it never pairs the array with
+   the size of another */
+struct Buckets {
+   /* the log base 2 of the number of buckets */
+   int bits;
+
+   /* the first binding of each bucket */
+   struct Binding *apsBindings[];
+};
+
+/* Each Retired is a removed binding that a reader may still be
+   using, along with the epoch in which it was removed */
+struct Retired {
+   /* the binding */
+   struct Binding *psBinding;
+
+   /* the epoch of the Table once the binding was unlinked */
+   size_t uEpoch;
+};
+
+/* Each Stripe holds the lock of every bucket whose index is
+   congruent to the index of the Stripe modulo the number of
+   stripes. A writer holds it exclusively, and so does a reader of
+   a table whose reads are not lock free. It also keeps the
+   bindings removed from its buckets until no reader can still be
+   using them. */
+struct Stripe {
+   /* the lock of the buckets of the Stripe */
+   pthread_rwlock_t lock;
+
+   /* the removed bindings, how many there are and how many fit */
+   struct Retired *psRetired;
+   size_t uRetiredCount;
+   size_t uRetiredSlots;
+
+   /* keeps the next Stripe off the cache line of this one */
+   char acPadding[CACHE_LINE_SIZE];
+};
+
+/* Each Reader belongs to a thread that has read a table with lock
+   free reads, and announces the epoch in which that thread's
+   current read started */
+struct Reader {
+   /* the epoch of the Table when the current read started, or 0
+      if the thread is not reading */
+   size_t uEpoch;
+
+   /* 1 (TRUE) while a thread owns the Reader, or 0 (FALSE) once
+      the thread has exited and another may take it */
+   int inUse;
+
+   /* The address of the next Reader */
+   struct Reader *psNextReader;
+
+   /* keeps the next Reader off the cache line of this one */
+   char acPadding[CACHE_LINE_SIZE];
+};
+
+/* Shard is a structure that contains the buckets of a part of a
+   thread safe SymTable and the stripes that lock them. Only a
+   thread holding every stripe of a Shard exclusively changes its
+   psBuckets and bucketBits, so a thread holding any one stripe sees
+   both of them unchanged. Each Shard resizes on its own. */
+struct Shard {
+   /* The number of elements contained within the Shard, which is
+      updated atomically */
+   size_t shardInputs;
+
+   /* the bucket array */
+   struct Buckets *psBuckets;
+
+   /* a copy of psBuckets->bits, which a thread can read before it
+      holds a stripe because resizes never free it */
+   int bucketBits;
+
+   /* the log base 2 of the number of shards of the Table, whose
+      hash code bits the buckets skip */
+   int shardBits;
+
+   /* the stripes of the buckets and how many there are */
+   struct Stripe *stripes;
+   size_t stripeCount;
+
+   /* held by the one thread that is resizing the Shard. Other
+      threads that find the Shard too full or too empty leave the
+      resize to it instead of waiting for the stripes */
+   pthread_mutex_t resizeLock;
+
+   /* the number of resizes, the most bindings one of them moved and
+      the number of bindings allocated, which are updated
+      atomically */
+   size_t uResizes;
+   size_t uMaxMoved;
+   size_t uAllocations;
+};
+
+/* Table is a structure that contains the shards of a thread safe
+   SymTable, and the epoch and Readers that let its reads be lock
+   free. */
+struct Table {
+   /* the shards and the log base 2 of their number */
+   struct Shard *shards;
+   int shardBits;
+
+   /* 1 (TRUE) if SymTable_get and SymTable_contains take no lock,
+      or 0 (FALSE) */
+   int lockFreeReads;
+
+   /* the current epoch, which starts at 1 and only grows. A binding
+      removed in an epoch is freed once every reader has announced
+      a later epoch or is not reading */
+   size_t epoch;
+
+   /* the Readers of the threads that have read the Table, and the
+      key of the thread specific data that holds each thread's
+      Reader */
+   struct Reader *psReaders;
+   pthread_key_t readerKey;
+};
+
+/* Takes in a full hash code, uHash. Returns the bits that choose
+   its shard and bucket. The multiplicative (Fibonacci) step spreads
+   the low quality low bits of uHash over the high bits. */
+static uint64_t SymTable_mix(size_t uHash) {
+   const uint64_t FIBONACCI_MULTIPLIER = UINT64_C(0x9E3779B97F4A7C15);
+
+   return (uint64_t)uHash * FIBONACCI_MULTIPLIER;
+}
+
+/* Takes in a full hash code, uHash, the log base 2 of the number of
+   shards, iShardBits, and the log base 2 of the number of buckets,
+   iBucketBits. Returns the bucket of uHash, which is between 0 and
+   2^iBucketBits - 1 inclusive, chosen by the mixed bits just below
+   the ones that choose its shard. */
+static size_t SymTable_bucket(size_t uHash, int iShardBits,
+                              int iBucketBits) {
+   return (size_t)((SymTable_mix(uHash) << iShardBits)
+                   >> (64 - iBucketBits));
+}
+
+/* Takes in a Table, oSymTable, and a full hash code, uHash. Returns
+   the shard of uHash, chosen by the high mixed bits. */
+static struct Shard *SymTable_shard(SymTable_T oSymTable,
+                                    size_t uHash) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->shardBits == 0)
+      return oSymTable->shards;
+   return &oSymTable->shards[SymTable_mix(uHash)
+                             >> (64 - oSymTable->shardBits)];
+}
+
+/* Takes in the log base 2 of a number of buckets, iBucketBits.
+   Returns a Buckets with that many empty buckets, or NULL if
+   insufficient memory is available. */
+static struct Buckets *SymTable_newBuckets(int iBucketBits) {
+   struct Buckets *psBuckets;
+   size_t uCount = (size_t)1 << iBucketBits;
+
+   /* checks that the size of the bucket array does not overflow */
+   if (uCount > ((size_t)-1 - sizeof(struct Buckets))
+       / sizeof(struct Binding*))
+      return NULL;
+
+   psBuckets = (struct Buckets*)calloc(1, sizeof(struct Buckets)
+                                       + uCount
+                                       * sizeof(struct Binding*));
+   if (psBuckets != NULL)
+      psBuckets->bits = iBucketBits;
+   return psBuckets;
+}
+
+/* Takes in a Shard, psShard, and a full hash code, uHash, of its
+   keys. Locks the stripe of the bucket of uHash, exclusively if
+   iWrite is 1 (TRUE) and shared otherwise, and returns the address
+   of the bucket. The bucket is looked up again if psShard was
+   resized before the stripe was locked. */
+static struct Binding **SymTable_lock(struct Shard *psShard,
+                                      size_t uHash, int iWrite) {
+   struct Stripe *psStripe;
+   int iBucketBits;
+   size_t uBucket;
+
+   assert(psShard != NULL);
+
+   for (;;) {
+      iBucketBits = SYMTABLE_LOAD(&psShard->bucketBits);
+      uBucket = SymTable_bucket(uHash, psShard->shardBits,
+                                iBucketBits);
+      psStripe = &psShard->stripes[uBucket % psShard->stripeCount];
+      if (iWrite)
+         pthread_rwlock_wrlock(&psStripe->lock);
+      else
+         pthread_rwlock_rdlock(&psStripe->lock);
+
+      /* no resize can start while the stripe is held */
+      if (SYMTABLE_LOAD(&psShard->bucketBits) == iBucketBits)
+         return &psShard->psBuckets->apsBindings[uBucket];
+      pthread_rwlock_unlock(&psStripe->lock);
+   }
+}
+
+/* Takes in a Shard, psShard, and a full hash code, uHash, whose
+   stripe the calling thread holds. Returns that stripe. */
+static struct Stripe *SymTable_stripe(struct Shard *psShard,
+                                      size_t uHash) {
+   size_t uBucket;
+
+   assert(psShard != NULL);
+
+   uBucket = SymTable_bucket(uHash, psShard->shardBits,
+                             psShard->bucketBits);
+   return &psShard->stripes[uBucket % psShard->stripeCount];
+}
+
+/* Takes in a Shard, psShard, and a full hash code, uHash, whose
+   stripe the calling thread holds. Unlocks that stripe. */
+static void SymTable_unlock(struct Shard *psShard, size_t uHash) {
+   assert(psShard != NULL);
+
+   pthread_rwlock_unlock(&SymTable_stripe(psShard, uHash)->lock);
+}
+
+/* Takes in a Shard, psShard, and locks every stripe of it,
+   exclusively if iWrite is 1 (TRUE) and shared otherwise. The
+   stripes are always locked in the same order so that two threads
+   locking all of them cannot deadlock. */
+static void SymTable_lockAll(struct Shard *psShard, int iWrite) {
+   /* for loop variable */
+   size_t i;
+
+   assert(psShard != NULL);
+
+   for (i = 0; i < psShard->stripeCount; i++) {
+      if (iWrite)
+         pthread_rwlock_wrlock(&psShard->stripes[i].lock);
+      else
+         pthread_rwlock_rdlock(&psShard->stripes[i].lock);
+   }
+}
+
+/* Takes in a Shard, psShard, whose stripes are all held by the
+   calling thread, and unlocks every stripe of it. */
+static void SymTable_unlockAll(struct Shard *psShard) {
+   /* for loop variable */
+   size_t i;
+
+   assert(psShard != NULL);
+
+   for (i = psShard->stripeCount; i > 0; i--)
+      pthread_rwlock_unlock(&psShard->stripes[i - 1].lock);
+}
+
+/* Takes in the Reader, pvReader, of a thread that is exiting, and
+   lets the next thread that reads the Table take it. */
+static void SymTable_releaseReader(void *pvReader) {
+   struct Reader *psReader = (struct Reader*)pvReader;
+
+   assert(psReader != NULL);
+
+   SYMTABLE_PUBLISH(&psReader->inUse, 0);
+}
+
+/* Takes in a Table with lock free reads, oSymTable. Returns the
+   Reader of the calling thread, taking one that an exited thread
+   released or adding a new one if the thread has none yet. Returns
+   NULL if insufficient memory is available. */
+static struct Reader *SymTable_reader(SymTable_T oSymTable) {
+   struct Reader *psReader;
+   int iFree;
+
+   assert(oSymTable != NULL);
+   assert(oSymTable->lockFreeReads);
+
+   psReader = (struct Reader*)pthread_getspecific(oSymTable->readerKey);
+   if (psReader != NULL)
+      return psReader;
+
+   /* takes a released Reader if there is one */
+   for (psReader = SYMTABLE_ACQUIRE(&oSymTable->psReaders);
+        psReader != NULL; psReader = psReader->psNextReader) {
+      iFree = 0;
+      if (__atomic_compare_exchange_n(&psReader->inUse, &iFree, 1, 0,
+                                      __ATOMIC_ACQUIRE,
+                                      __ATOMIC_RELAXED))
+         break;
+   }
+
+   /* otherwise pushes a new Reader onto the list */
+   if (psReader == NULL) {
+      psReader = (struct Reader*)malloc(sizeof(struct Reader));
+      if (psReader == NULL)
+         return NULL;
+      psReader->uEpoch = 0;
+      psReader->inUse = 1;
+      psReader->psNextReader = SYMTABLE_LOAD(&oSymTable->psReaders);
+      while (!__atomic_compare_exchange_n(&oSymTable->psReaders,
+                                          &psReader->psNextReader,
+                                          psReader, 1,
+                                          __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED))
+         ;
+   }
+
+   if (pthread_setspecific(oSymTable->readerKey, psReader) != 0) {
+      SymTable_releaseReader(psReader);
+      return NULL;
+   }
+   return psReader;
+}
+
+/* Takes in a Table with lock free reads, oSymTable. Starts a new
+   epoch and returns the earliest epoch that a reader has announced,
+   or the new epoch if no thread is reading. Each epoch is read with
+   acquire, so that seeing the 0 that a reader publishes when it is
+   done orders its last load of a binding before the free. */
+static size_t SymTable_oldestEpoch(SymTable_T oSymTable) {
+   struct Reader *psReader;
+   size_t uOldest;
+   size_t uEpoch;
+
+   assert(oSymTable != NULL);
+
+   uOldest = __atomic_add_fetch(&oSymTable->epoch, 1,
+                                __ATOMIC_SEQ_CST);
+   SYMTABLE_FENCE();
+   for (psReader = SYMTABLE_ACQUIRE(&oSymTable->psReaders);
+        psReader != NULL; psReader = psReader->psNextReader) {
+      uEpoch = SYMTABLE_ACQUIRE(&psReader->uEpoch);
+      if (uEpoch != 0 && uEpoch < uOldest)
+         uOldest = uEpoch;
+   }
+   return uOldest;
+}
+
+/* Takes in a Table with lock free reads, oSymTable. Waits until
+   every read that had started has finished, so that a binding or
+   bucket array unlinked beforehand can be freed. Reads each epoch
+   with acquire, as SymTable_oldestEpoch does. */
+static void SymTable_synchronize(SymTable_T oSymTable) {
+   struct Reader *psReader;
+   size_t uEpoch;
+   size_t uNewEpoch;
+
+   assert(oSymTable != NULL);
+
+   uNewEpoch = __atomic_add_fetch(&oSymTable->epoch, 1,
+                                  __ATOMIC_SEQ_CST);
+   SYMTABLE_FENCE();
+   for (psReader = SYMTABLE_ACQUIRE(&oSymTable->psReaders);
+        psReader != NULL; psReader = psReader->psNextReader) {
+      for (;;) {
+         uEpoch = SYMTABLE_ACQUIRE(&psReader->uEpoch);
+         if (uEpoch == 0 || uEpoch >= uNewEpoch)
+            break;
+         sched_yield();
+      }
+   }
+}
+
+/* Takes in a Table with lock free reads, oSymTable, and one of its
+   stripes, psStripe, that the calling thread holds exclusively.
+   Frees every binding that psStripe retired before the earliest
+   epoch a reader has announced. */
+static void SymTable_reclaim(SymTable_T oSymTable,
+                             struct Stripe *psStripe) {
+   size_t uOldest;
+   size_t uKept = 0;
+   /* for loop variable */
+   size_t i;
+
+   assert(oSymTable != NULL);
+   assert(psStripe != NULL);
+
+   uOldest = SymTable_oldestEpoch(oSymTable);
+   for (i = 0; i < psStripe->uRetiredCount; i++) {
+      if (psStripe->psRetired[i].uEpoch < uOldest)
+         free(psStripe->psRetired[i].psBinding);
+      else
+         psStripe->psRetired[uKept++] = psStripe->psRetired[i];
+   }
+   psStripe->uRetiredCount = uKept;
+}
+
+/* Takes in a Table with lock free reads, oSymTable, one of its
+   stripes, psStripe, that the calling thread holds exclusively, and
+   a binding, psBinding, just unlinked from a bucket of psStripe.
+   Frees psBinding once no reader can still be using it. */
+static void SymTable_retire(SymTable_T oSymTable,
+                            struct Stripe *psStripe,
+                            struct Binding *psBinding) {
+   struct Retired *psRetired;
+   size_t uSlots;
+
+   assert(oSymTable != NULL);
+   assert(psStripe != NULL);
+   assert(psBinding != NULL);
+
+   /* grows the array of retired bindings, or waits for every reader
+      and frees psBinding now if insufficient memory is available */
+   if (psStripe->uRetiredCount == psStripe->uRetiredSlots) {
+      uSlots = (psStripe->uRetiredSlots == 0) ? RETIRE_BATCH
+         : psStripe->uRetiredSlots * 2;
+      psRetired = (struct Retired*)realloc(psStripe->psRetired,
+                                           uSlots
+                                           * sizeof(struct Retired));
+      if (psRetired == NULL) {
+         SymTable_synchronize(oSymTable);
+         free(psBinding);
+         return;
+      }
+      psStripe->psRetired = psRetired;
+      psStripe->uRetiredSlots = uSlots;
+   }
+
+   /* records the epoch once the unlink is visible to readers */
+   SYMTABLE_FENCE();
+   psRetired = &psStripe->psRetired[psStripe->uRetiredCount++];
+   psRetired->psBinding = psBinding;
+   psRetired->uEpoch = SYMTABLE_LOAD(&oSymTable->epoch);
+
+   if (psStripe->uRetiredCount >= RETIRE_BATCH)
+      SymTable_reclaim(oSymTable, psStripe);
+}
+
+/* Takes in the bucket array of a Table, psBuckets, and frees every
+   binding in it. */
+static void SymTable_freeBindings(struct Buckets *psBuckets) {
+   struct Binding *psCurrentBinding;
+   struct Binding *psNextBinding;
+   /* for loop variable */
+   size_t i;
+
+   assert(psBuckets != NULL);
+
+   for (i = 0; i < (size_t)1 << psBuckets->bits; i++) {
+      for (psCurrentBinding = psBuckets->apsBindings[i];
+           psCurrentBinding != NULL;
+           psCurrentBinding = psNextBinding) {
+         /* maintains access to the next binding */
+         psNextBinding = psCurrentBinding->psNextBinding;
+
+         /* frees the binding along with its key */
+         free(psCurrentBinding);
+      }
+   }
+}
+
+/* Takes in a bucket array, psOld, an empty bucket array, psNew,
+   and the log base 2 of the number of shards of their Table,
+   iShardBits. Links every binding of psOld into its bucket in
+   psNew. If iCopy is 1 (TRUE), links copies and leaves the chains
+   of psOld unchanged for the readers that may be walking them.
+   Returns 1 if successful, or 0 leaving psNew empty if insufficient
+   memory is available for the copies. */
+static int SymTable_rehash(struct Buckets *psOld,
+                           struct Buckets *psNew, int iShardBits,
+                           int iCopy) {
+   struct Binding *psCurrentBinding;
+   struct Binding *psNextBinding;
+   struct Binding *psMoved;
+   size_t uBucket;
+   size_t uSize;
+   /* for loop variable */
+   size_t i;
+
+   assert(psOld != NULL);
+   assert(psNew != NULL);
+
+   for (i = 0; i < (size_t)1 << psOld->bits; i++) {
+      for (psCurrentBinding = psOld->apsBindings[i];
+           psCurrentBinding != NULL;
+           psCurrentBinding = psNextBinding) {
+         psNextBinding = psCurrentBinding->psNextBinding;
+         psMoved = psCurrentBinding;
+         if (iCopy) {
+            uSize = sizeof(struct Binding)
+               + psCurrentBinding->uKeyLength + 1;
+            psMoved = (struct Binding*)malloc(uSize);
+            if (psMoved == NULL) {
+               SymTable_freeBindings(psNew);
+               memset(psNew->apsBindings, 0,
+                      ((size_t)1 << psNew->bits)
+                      * sizeof(struct Binding*));
+               return 0;
+            }
+            memcpy(psMoved, psCurrentBinding, uSize);
+         }
+         uBucket = SymTable_bucket(psMoved->uHash, iShardBits,
+                                   psNew->bits);
+         psMoved->psNextBinding = psNew->apsBindings[uBucket];
+         psNew->apsBindings[uBucket] = psMoved;
+      }
+   }
+   return 1;
+}
+
+/* Takes in a Table, oSymTable, and one of its shards, psShard, that
+   may have become too full or too empty. Unless another thread is
+   already resizing psShard, locks every stripe of psShard, checks
+   the number of bindings again, and moves every binding of psShard
+   into a bucket array of twice or half the size. The other shards
+   are not affected. With lock free reads, the bindings are copied
+   and the old ones are freed with their bucket array once every
+   read that may be using them has finished. psShard is left
+   unchanged if insufficient memory is available. */
+static void SymTable_resize(SymTable_T oSymTable,
+                            struct Shard *psShard) {
+   struct Buckets *psOld;
+   struct Buckets *psNew;
+   size_t uInputs;
+   size_t uOldCount;
+   int iNewBits;
+
+   assert(oSymTable != NULL);
+   assert(psShard != NULL);
+
+   /* the thread already resizing sees the bindings this thread
+      added or removed once it holds the stripes */
+   if (pthread_mutex_trylock(&psShard->resizeLock) != 0)
+      return;
+   SymTable_lockAll(psShard, 1);
+
+   /* chooses the new size from the number of bindings now. The
+      bits of the shard and the bucket have to fit in the 64 mixed
+      bits */
+   psOld = psShard->psBuckets;
+   uInputs = SYMTABLE_LOAD(&psShard->shardInputs);
+   uOldCount = (size_t)1 << psOld->bits;
+   iNewBits = psOld->bits;
+   if (uInputs > uOldCount && iNewBits < (int)(sizeof(size_t) * 8) - 1
+       && iNewBits + psShard->shardBits < 64)
+      iNewBits++;
+   else if (uInputs < uOldCount / SHRINK_DIVISOR
+            && iNewBits > INITIAL_BUCKET_BITS)
+      iNewBits--;
+
+   /* moves every binding unless memory runs out */
+   psNew = NULL;
+   if (iNewBits != psOld->bits) {
+      psNew = SymTable_newBuckets(iNewBits);
+      if (psNew != NULL
+          && !SymTable_rehash(psOld, psNew, psShard->shardBits,
+                              oSymTable->lockFreeReads)) {
+         free(psNew);
+         psNew = NULL;
+      }
+   }
+   if (psNew != NULL) {
+      SYMTABLE_PUBLISH(&psShard->psBuckets, psNew);
+      SYMTABLE_STORE(&psShard->bucketBits, iNewBits);
+      SYMTABLE_STORE(&psShard->uResizes, psShard->uResizes + 1);
+      if (uInputs > psShard->uMaxMoved)
+         SYMTABLE_STORE(&psShard->uMaxMoved, uInputs);
+   }
+   SymTable_unlockAll(psShard);
+
+   /* frees the old bucket array, and the bindings that were copied
+      out of it, once no reader can still be walking it */
+   if (psNew != NULL) {
+      if (oSymTable->lockFreeReads) {
+         SymTable_synchronize(oSymTable);
+         SymTable_freeBindings(psOld);
+      }
+      free(psOld);
+   }
+   pthread_mutex_unlock(&psShard->resizeLock);
+}
+
+/* Takes in a Shard, psShard, whose locks have been created, and
+   frees its bindings, its retired bindings and its locks. */
+static void SymTable_freeShard(struct Shard *psShard) {
+   struct Stripe *psStripe;
+   /* for loop variables */
+   size_t i;
+   size_t j;
+
+   assert(psShard != NULL);
+
+   SymTable_freeBindings(psShard->psBuckets);
+   for (i = 0; i < psShard->stripeCount; i++) {
+      psStripe = &psShard->stripes[i];
+      for (j = 0; j < psStripe->uRetiredCount; j++)
+         free(psStripe->psRetired[j].psBinding);
+      free(psStripe->psRetired);
+      pthread_rwlock_destroy(&psStripe->lock);
+   }
+   pthread_mutex_destroy(&psShard->resizeLock);
+   free(psShard->stripes);
+   free(psShard->psBuckets);
+}
+
+/* Takes in a Shard, psShard, the log base 2 of the number of shards
+   of its Table, iShardBits, and a number of stripes, uStripeCount.
+   Makes psShard empty with the initial number of buckets. Returns 1
+   if successful, or 0 leaving nothing to free if insufficient
+   memory or locks are available. */
+static int SymTable_initShard(struct Shard *psShard, int iShardBits,
+                              size_t uStripeCount) {
+   /* for loop variable */
+   size_t i;
+
+   assert(psShard != NULL);
+   assert(uStripeCount > 0);
+
+   /* starts empty with the initial number of buckets */
+   psShard->shardInputs = 0;
+   psShard->bucketBits = INITIAL_BUCKET_BITS;
+   psShard->shardBits = iShardBits;
+   psShard->psBuckets = SymTable_newBuckets(INITIAL_BUCKET_BITS);
+   psShard->stripeCount = uStripeCount;
+   psShard->stripes = (struct Stripe*)
+      calloc(uStripeCount, sizeof(struct Stripe));
+   psShard->uResizes = 0;
+   psShard->uMaxMoved = 0;
+   psShard->uAllocations = 0;
+
+   /* checks to see if calloc failed */
+   if (psShard->psBuckets == NULL || psShard->stripes == NULL) {
+      free(psShard->psBuckets);
+      free(psShard->stripes);
+      return 0;
+   }
+
+   /* creates the locks, which only fail for lack of resources */
+   for (i = 0; i < uStripeCount; i++)
+      if (pthread_rwlock_init(&psShard->stripes[i].lock, NULL) != 0)
+         break;
+   if (i == uStripeCount
+       && pthread_mutex_init(&psShard->resizeLock, NULL) == 0)
+      return 1;
+   while (i > 0)
+      pthread_rwlock_destroy(&psShard->stripes[--i].lock);
+   free(psShard->psBuckets);
+   free(psShard->stripes);
+   return 0;
+}
+
+/* Takes in a number of shards, uShardCount, a number of stripes of
+   each shard, uStripeCount, and an int, iLockFreeReads, that is 1
+   (TRUE) for a table whose reads take no lock. Returns a new empty
+   SymTable_T, or NULL if insufficient memory is available. */
+static SymTable_T SymTable_create(size_t uShardCount,
+                                  size_t uStripeCount,
+                                  int iLockFreeReads){
+   SymTable_T oSymTable;
+   int iShardBits = 0;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures at least one shard and stripe */
+   assert(uShardCount > 0);
+   assert(uStripeCount > 0);
+
+   /* rounds the number of shards up to a power of two */
+   while (((size_t)1 << iShardBits) < uShardCount
+          && iShardBits < MAX_SHARD_BITS)
+      iShardBits++;
+
+   /* intilizes the size of oSymTable to be the same size as
+      the Table struct */
+   oSymTable = (SymTable_T)malloc(sizeof(struct Table));
+
+   /* checks to see if malloc failed */
+   if (oSymTable == NULL)
+      return NULL;
+
+   oSymTable->shardBits = iShardBits;
+   oSymTable->lockFreeReads = iLockFreeReads;
+   oSymTable->epoch = 1;
+   oSymTable->psReaders = NULL;
+   oSymTable->shards = (struct Shard*)
+      malloc(sizeof(struct Shard) * ((size_t)1 << iShardBits));
+
+   /* checks to see if malloc failed */
+   if (oSymTable->shards == NULL) {
+      free(oSymTable);
+      return NULL;
+   }
+
+   /* creates the shards and the key of the Readers */
+   for (i = 0; i < (size_t)1 << iShardBits; i++)
+      if (!SymTable_initShard(&oSymTable->shards[i], iShardBits,
+                              uStripeCount))
+         break;
+   if (i == (size_t)1 << iShardBits
+       && (!iLockFreeReads
+           || pthread_key_create(&oSymTable->readerKey,
+                                 SymTable_releaseReader) == 0))
+      return oSymTable;
+   while (i > 0)
+      SymTable_freeShard(&oSymTable->shards[--i]);
+   free(oSymTable->shards);
+   free(oSymTable);
+   return NULL;
+}
+
+SymTable_T SymTable_new(void){
+   return SymTable_create(1, DEFAULT_STRIPE_COUNT, 0);
+}
+
+SymTable_T SymTable_newConcurrent(size_t uStripeCount){
+   return SymTable_create(1, uStripeCount, 0);
+}
+
+SymTable_T SymTable_newLockFreeReads(size_t uStripeCount){
+   return SymTable_create(1, uStripeCount, 1);
+}
+
+SymTable_T SymTable_newSharded(size_t uShardCount,
+                               size_t uStripeCount){
+   return SymTable_create(uShardCount, uStripeCount, 0);
+}
+
+void SymTable_free(SymTable_T oSymTable){
+   struct Reader *psReader;
+   struct Reader *psNextReader;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* iterates through oSymTable freeing all memory. No other
+      thread may be using oSymTable any more, so no lock is taken
+      and every retired binding can be freed */
+   for (i = 0; i < (size_t)1 << oSymTable->shardBits; i++)
+      SymTable_freeShard(&oSymTable->shards[i]);
+
+   /* deletes the key first, so that no exiting thread releases a
+      Reader after it has been freed */
+   if (oSymTable->lockFreeReads) {
+      pthread_key_delete(oSymTable->readerKey);
+      for (psReader = oSymTable->psReaders; psReader != NULL;
+           psReader = psNextReader) {
+         psNextReader = psReader->psNextReader;
+         free(psReader);
+      }
+   }
+
+   /* frees the shards and the oSymTable structure */
+   free(oSymTable->shards);
+   free(oSymTable);
+}
+
+size_t SymTable_getLength(SymTable_T oSymTable){
+   size_t uLength = 0;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* returns the number of inputs wihtin oSymTable, summed over its
+      shards */
+   for (i = 0; i < (size_t)1 << oSymTable->shardBits; i++)
+      uLength += SYMTABLE_LOAD(&oSymTable->shards[i].shardInputs);
+   return uLength;
+}
+
+/* Takes in the address of a bucket, ppsBucket, whose stripe the
+   calling thread holds, a key, pcKey, its full hash code, uHash,
+   and its length, uLength. Returns the link to the binding with
+   pcKey in the chain of ppsBucket, or the NULL link that ends that
+   chain if there is no such binding. */
+static struct Binding **SymTable_find(struct Binding **ppsBucket,
+                                      const char *pcKey, size_t uHash,
+                                      size_t uLength) {
+   struct Binding **ppsLink;
+
+   assert(ppsBucket != NULL);
+   assert(pcKey != NULL);
+
+   for (ppsLink = ppsBucket; *ppsLink != NULL;
+        ppsLink = &(*ppsLink)->psNextBinding) {
+      if ((*ppsLink)->uHash == uHash
+          && (*ppsLink)->uKeyLength == uLength
+          && memcmp((*ppsLink)->acKey, pcKey, uLength) == 0)
+         break;
+   }
+   return ppsLink;
+}
+
+/* Takes in a Table, oSymTable, and a key, pcKey. Returns 1 (TRUE)
+   and stores the value of the binding with pcKey in *ppvValue if
+   oSymTable contains pcKey, or returns 0 (FALSE). With lock free
+   reads, the chain is walked without a lock while the calling
+   thread's Reader announces the epoch, so that no binding it
+   reaches is freed before it is done. */
+static int SymTable_search(SymTable_T oSymTable, const char *pcKey,
+                           void **ppvValue) {
+   struct Binding **ppsLink;
+   struct Binding *psBinding;
+   struct Buckets *psBuckets;
+   struct Shard *psShard;
+   struct Reader *psReader = NULL;
+   size_t uHash;
+   size_t uLength;
+   int iFound = 0;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+   assert(ppvValue != NULL);
+
+   uHash = SymHash_hashString(SYMHASH_LEGACY, pcKey, &uLength);
+   psShard = SymTable_shard(oSymTable, uHash);
+   if (oSymTable->lockFreeReads)
+      psReader = SymTable_reader(oSymTable);
+
+   /* searches for pcKey holding its stripe shared if the read
+      cannot be lock free */
+   if (psReader == NULL) {
+      ppsLink = SymTable_find(SymTable_lock(psShard, uHash, 0),
+                              pcKey, uHash, uLength);
+      if (*ppsLink != NULL) {
+         *ppvValue = (*ppsLink)->pvValue;
+         iFound = 1;
+      }
+      SymTable_unlock(psShard, uHash);
+      return iFound;
+   }
+
+   /* announces the epoch before loading any link */
+   SYMTABLE_STORE(&psReader->uEpoch,
+                  SYMTABLE_LOAD(&oSymTable->epoch));
+   SYMTABLE_FENCE();
+
+   psBuckets = SYMTABLE_ACQUIRE(&psShard->psBuckets);
+   for (psBinding = SYMTABLE_ACQUIRE(&psBuckets->apsBindings[
+           SymTable_bucket(uHash, psShard->shardBits,
+                           psBuckets->bits)]);
+        psBinding != NULL;
+        psBinding = SYMTABLE_ACQUIRE(&psBinding->psNextBinding)) {
+      if (psBinding->uHash == uHash
+          && psBinding->uKeyLength == uLength
+          && memcmp(psBinding->acKey, pcKey, uLength) == 0) {
+         *ppvValue = SYMTABLE_LOAD(&psBinding->pvValue);
+         iFound = 1;
+         break;
+      }
+   }
+
+   /* lets writers free what this read has seen */
+   SYMTABLE_PUBLISH(&psReader->uEpoch, 0);
+   return iFound;
+}
+
+int SymTable_put(SymTable_T oSymTable, const char *pcKey,
+                 const void *pvValue) {
+   struct Binding **ppsLink;
+   struct Binding *psNewBinding;
+   struct Shard *psShard;
+   size_t uHash;
+   size_t uLength;
+   size_t uInputs;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* hashes and allocates before locking, so that the stripe is
+      held only while the chain is searched and linked */
+   uHash = SymHash_hashString(SYMHASH_LEGACY, pcKey, &uLength);
+   psShard = SymTable_shard(oSymTable, uHash);
+   psNewBinding = (struct Binding*)
+      malloc(sizeof(struct Binding) + uLength + 1);
+
+   /* checks to see if malloc failed */
+   if (psNewBinding == NULL)
+      return 0;
+   memcpy(psNewBinding->acKey, pcKey, uLength + 1);
+   psNewBinding->pvValue = (void*)pvValue;
+   psNewBinding->uHash = uHash;
+   psNewBinding->uKeyLength = uLength;
+   psNewBinding->psNextBinding = NULL;
+
+   /* adds the binding only if pcKey is not found, publishing it
+      once it has been fully written */
+   ppsLink = SymTable_find(SymTable_lock(psShard, uHash, 1), pcKey,
+                           uHash, uLength);
+   if (*ppsLink != NULL) {
+      SymTable_unlock(psShard, uHash);
+      free(psNewBinding);
+      return 0;
+   }
+   SYMTABLE_PUBLISH(ppsLink, psNewBinding);
+   uInputs = __atomic_add_fetch(&psShard->shardInputs, 1,
+                                __ATOMIC_RELAXED);
+   SymTable_unlock(psShard, uHash);
+   __atomic_add_fetch(&psShard->uAllocations, 1, __ATOMIC_RELAXED);
+
+   /* grows the shard once it has more bindings than buckets */
+   if (uInputs > (size_t)1 << SYMTABLE_LOAD(&psShard->bucketBits))
+      SymTable_resize(oSymTable, psShard);
+   return 1;
+}
+
+void *SymTable_replace(SymTable_T oSymTable, const char *pcKey,
+                       const void *pvValue) {
+   struct Binding **ppsLink;
+   struct Shard *psShard;
+   void *oldValue = NULL;
+   size_t uHash;
+   size_t uLength;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* replaces the value of the binding with pcKey if there is one,
+      returning its old value */
+   uHash = SymHash_hashString(SYMHASH_LEGACY, pcKey, &uLength);
+   psShard = SymTable_shard(oSymTable, uHash);
+   ppsLink = SymTable_find(SymTable_lock(psShard, uHash, 1), pcKey,
+                           uHash, uLength);
+   if (*ppsLink != NULL) {
+      oldValue = (*ppsLink)->pvValue;
+      SYMTABLE_STORE(&(*ppsLink)->pvValue, (void*)pvValue);
+   }
+   SymTable_unlock(psShard, uHash);
+   return oldValue;
+}
+
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey){
+   void *pvValue;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   return SymTable_search(oSymTable, pcKey, &pvValue);
+}
+
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey){
+   void *pvValue;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* returns the value of the binding with pcKey if there is one */
+   if (!SymTable_search(oSymTable, pcKey, &pvValue))
+      return NULL;
+   return pvValue;
+}
+
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey){
+   struct Binding **ppsLink;
+   struct Binding *psCurrentBinding;
+   struct Shard *psShard;
+   void *bindingValue;
+   size_t uHash;
+   size_t uLength;
+   size_t uInputs;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* searches for the binding with pcKey */
+   uHash = SymHash_hashString(SYMHASH_LEGACY, pcKey, &uLength);
+   psShard = SymTable_shard(oSymTable, uHash);
+   ppsLink = SymTable_find(SymTable_lock(psShard, uHash, 1), pcKey,
+                           uHash, uLength);
+   psCurrentBinding = *ppsLink;
+   if (psCurrentBinding == NULL) {
+      SymTable_unlock(psShard, uHash);
+      return NULL;
+   }
+
+   /* removes the current binding by linking the previous
+      binding, or the bucket, with the next binding. A reader on
+      the binding can still follow its link */
+   SYMTABLE_PUBLISH(ppsLink, psCurrentBinding->psNextBinding);
+   bindingValue = psCurrentBinding->pvValue;
+   uInputs = __atomic_sub_fetch(&psShard->shardInputs, 1,
+                                __ATOMIC_RELAXED);
+
+   /* frees the binding once no other thread can reach it */
+   if (oSymTable->lockFreeReads) {
+      SymTable_retire(oSymTable, SymTable_stripe(psShard, uHash),
+                      psCurrentBinding);
+      SymTable_unlock(psShard, uHash);
+   }
+   else {
+      SymTable_unlock(psShard, uHash);
+      free(psCurrentBinding);
+   }
+
+   /* shrinks the shard once it has few enough bindings to release
+      most of its buckets */
+   if (uInputs < ((size_t)1 << SYMTABLE_LOAD(&psShard->bucketBits))
+       / SHRINK_DIVISOR
+       && SYMTABLE_LOAD(&psShard->bucketBits) > INITIAL_BUCKET_BITS)
+      SymTable_resize(oSymTable, psShard);
+
+   return bindingValue;
+}
+
+void SymTable_map(SymTable_T oSymTable,
+                  void (*pfApply) (const char *pcKey, void
+                                   *pvValue, void *pvExtra),
+                  const void *pvExtra){
+   struct Binding *psCurrentBinding;
+   struct Shard *psShard;
+   /* for loop variables */
+   size_t i;
+   size_t j;
+
+   /* ensures no null input where unexpected.
+      pvExtra can be NULL */
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   /* iterates through every shard holding all of its stripes
+      shared, so that the bindings seen in each shard are the ones
+      of one moment. *pfApply therefore must not call back into
+      oSymTable, since a writer would wait for these stripes
+      forever */
+   for (j = 0; j < (size_t)1 << oSymTable->shardBits; j++) {
+      psShard = &oSymTable->shards[j];
+      SymTable_lockAll(psShard, 0);
+      for (i = 0; i < (size_t)1 << psShard->bucketBits; i++) {
+         for (psCurrentBinding = psShard->psBuckets->apsBindings[i];
+              psCurrentBinding != NULL;
+              psCurrentBinding = psCurrentBinding->psNextBinding) {
+            /* applies function *pfApply to each binding in
+               oSymtable passing pvExtra as an extra parameter*/
+            (*pfApply)(psCurrentBinding->acKey,
+                       psCurrentBinding->pvValue,
+                       (void*)pvExtra);
+         }
+      }
+      SymTable_unlockAll(psShard);
+   }
+}
+
+/* Takes in a Shard, psShard, and stores the statistics it has
+   collected in *psStats. */
+static void SymTable_shardStats(struct Shard *psShard,
+                                struct SymTable_Stats *psStats) {
+   assert(psShard != NULL);
+   assert(psStats != NULL);
+
+   memset(psStats, 0, sizeof(*psStats));
+   psStats->uResizes = SYMTABLE_LOAD(&psShard->uResizes);
+   psStats->uMaxMoved = SYMTABLE_LOAD(&psShard->uMaxMoved);
+   psStats->uBindingAllocations =
+      SYMTABLE_LOAD(&psShard->uAllocations);
+}
+
+void SymTable_getStats(SymTable_T oSymTable,
+                       struct SymTable_Stats *psStats){
+   struct SymTable_Stats sShardStats;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(psStats != NULL);
+
+   /* sums the counts of the shards and keeps the largest resize */
+   memset(psStats, 0, sizeof(*psStats));
+   for (i = 0; i < (size_t)1 << oSymTable->shardBits; i++) {
+      SymTable_shardStats(&oSymTable->shards[i], &sShardStats);
+      psStats->uResizes += sShardStats.uResizes;
+      psStats->uBindingAllocations += sShardStats.uBindingAllocations;
+      if (sShardStats.uMaxMoved > psStats->uMaxMoved)
+         psStats->uMaxMoved = sShardStats.uMaxMoved;
+   }
+}
+
+size_t SymTable_getShardStats(SymTable_T oSymTable,
+                              struct SymTable_Stats asStats[],
+                              size_t uCount){
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(asStats != NULL || uCount == 0);
+
+   for (i = 0; i < uCount && i < (size_t)1 << oSymTable->shardBits;
+        i++)
+      SymTable_shardStats(&oSymTable->shards[i], &asStats[i]);
+   return (size_t)1 << oSymTable->shardBits;
+}
@@ -2,29 +2,121 @@
 
 /* includes libraries*/
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "symtable.h"
+#include "sympool.h"
+#include "symthreads.h"
+
+/* applies X to the index and value of every available bucket size.
+   The first size is the array inside every Table, which holds the
+   few bindings of a small table without allocating a bucket array.
+   Each other size is the largest prime below a power of two, and
+   the list continues until a bucket array could never be allocated,
+   so growing has no practical ceiling */
+#define BUCKET_COUNTS_32(X) \
+   X(0, 7) X(1, 509) X(2, 1021) X(3, 2039) X(4, 4093) X(5, 8191) \
+   X(6, 16381) X(7, 32749) X(8, 65521) X(9, 131071) X(10, 262139) \
+   X(11, 524287) X(12, 1048573) X(13, 2097143) X(14, 4194301) \
+   X(15, 8388593) X(16, 16777213) X(17, 33554393) \
+   X(18, 67108859) X(19, 134217689) X(20, 268435399) \
+   X(21, 536870909) X(22, 1073741789) X(23, 2147483647) \
+   X(24, 4294967291)
+#if SIZE_MAX > 4294967295u
+#define BUCKET_COUNTS(X) BUCKET_COUNTS_32(X) \
+   X(25, 8589934583) X(26, 17179869143) X(27, 34359738337) \
+   X(28, 68719476731) X(29, 137438953447) X(30, 274877906899) \
+   X(31, 549755813881) X(32, 1099511627689) \
+   X(33, 2199023255531) X(34, 4398046511093) \
+   X(35, 8796093022151) X(36, 17592186044399) \
+   X(37, 35184372088777) X(38, 70368744177643) \
+   X(39, 140737488355213)
+#else
+#define BUCKET_COUNTS(X) BUCKET_COUNTS_32(X)
+#endif
+
+/* expands to one element of bucketArray */
+#define BUCKET_COUNT_ELEMENT(index, count) (size_t)count,
 
 /* array that stores the available bucket sizes */
-static const size_t bucketArray[] = {509, 1021, 2039, 4093, 8191,
-   16381, 32749, 65521};
+static const size_t bucketArray[] = {
+   BUCKET_COUNTS(BUCKET_COUNT_ELEMENT)
+};
 
 /* stores the length of bucketArray */
 static const size_t numBucketCounts = sizeof(bucketArray)
    /sizeof(bucketArray[0]);
 
+/* the number of old buckets an operation moves to the new bucket
+   array while an incremental resize is in progress. Growing only
+   doubles the bucket count, so every old bucket has been moved
+   long before the next resize is needed */
+enum {MIGRATE_BUCKETS = 8};
+
+/* the number of buckets inside every Table, which is the first
+   bucket count of BUCKET_COUNTS_32 */
+enum {INLINE_BUCKETS = 7};
+
+/* a Table shrinks once it holds fewer than 1 / SHRINK_DIVISOR of
+   the bindings that would make the next smaller bucket array grow.
+   Apart from the jump from INLINE_BUCKETS to the second bucket
+   count, each bucket count doubles the one before, so that is about
+   a quarter of the bindings that would make the Table grow */
+enum {SHRINK_DIVISOR = 2};
+
+/* the number of keys that SymTable_putBatch and SymTable_getMany
+   hash before searching for any of them, and how many keys ahead
+   of the one being linked SymTable_putBatch prefetches the first
+   binding of a bucket */
+enum {BATCH_CHUNK = 64};
+enum {PREFETCH_DISTANCE = 8};
+
+/* the number of buckets that a worker of SymTable_mapReduce takes
+   at a time. Workers take the next chunk as soon as they finish
+   one, so a worker slowed by long chains or costly bindings takes
+   fewer chunks */
+enum {MAP_CHUNK = 256};
+
+/* the number of bindings from which a Table moves every binding of
+   a resize with several threads, unless SymTable_setParallelResize
+   changes it, and the number of old buckets that a worker of such
+   a move takes at a time */
+enum {PARALLEL_RESIZE_THRESHOLD = 1 << 20};
+enum {REHASH_CHUNK = 1024};
+
+/* asks the processor to start loading the cache line at an address
+   that will be read soon */
+#ifdef __GNUC__
+#define SYMTABLE_PREFETCH(pv) __builtin_prefetch(pv)
+#else
+#define SYMTABLE_PREFETCH(pv) ((void)(pv))
+#endif
+
 /* Each item is stored in a Binding.
    Bindings are linked to form a Table*/
 struct Binding {
    /* stores the value of the binding */
-   const void *pvValue;
-
-   /* stores the key of the binding */
-   const char *pcKey;
+   void *pvValue;
 
    /* The address of the next Binding*/
    struct Binding *psNextBinding;
+
+   /* stores the full hash code of the key, so that resizing never
+      rehashes keys and lookups compare it before the keys */
+   size_t uHash;
+
+   /* stores the length of the key */
+   size_t uKeyLength;
+
+   /* stores the key of the binding, which is either acKey or the
+      key of an atom that the binding shares instead of copying */
+   const char *pcKey;
+
+   /* stores the defensive copy of the key of the binding, which is
+      allocated together with the binding so that a lookup reads the
+      key from the same cache line as the link to it */
+   char acKey[];
 };
 
 /* Table is a structure that contains a pointer to a pointer
@@ -42,103 +134,516 @@ struct Table {
 
    /* idex to the bucketArray containing the bucket size*/
    int bucketIndex;
+
+   /* the bucket array being moved into buckets while a resize is
+      in progress, or NULL if no resize is in progress */
+   struct Binding **oldBuckets;
+
+   /* idex to the bucketArray containing the size of oldBuckets */
+   int oldBucketIndex;
+
+   /* the number of old buckets that have already been moved.
+      Bindings in old buckets below migrateCursor are in buckets */
+   size_t migrateCursor;
+
+   /* 1 if resizes are done incrementally, 0 otherwise */
+   int incremental;
+
+   /* the number of bindings from which a resize that moves every
+      binding at once moves them with several threads, and the
+      number of threads, or 0 for one per online processor */
+   size_t parallelThreshold;
+   size_t parallelThreads;
+
+   /* the average number of bindings per bucket above which the
+      Table grows */
+   double loadFactor;
+
+   /* the number of bindings above which the Table grows */
+   size_t growLimit;
+
+   /* the number of bindings below which the Table shrinks */
+   size_t shrinkLimit;
+
+   /* the statistics reported by SymTable_getStats */
+   struct SymTable_Stats stats;
+
+   /* the hash function of the keys. The bucket that a key is
+      inserted within is its full width hash code modulo the bucket
+      count, which is between 0 and the bucket count - 1 inclusive */
+   enum SymHash_Function hashFunction;
+
+   /* the allocator of the bindings, which reuses the storage of
+      removed bindings, or NULL until the first binding is inserted,
+      so that a new Table is a single allocation */
+   SymPool_T pool;
+
+   /* 1 (TRUE) if pool is a region, or 0 (FALSE) */
+   int regionPool;
+
+   /* 1 (TRUE) if the bindings store the keys passed to
+      SymTable_put instead of copies, or 0 (FALSE) */
+   int borrowedKeys;
+
+   /* the buckets of a Table with the first bucket count, so that a
+      new or small Table allocates no bucket array */
+   struct Binding *inlineBuckets[INLINE_BUCKETS];
 };
 
-/* Hash function ensuring that bindings inserted in the table
-   are evenely distrubeted throughout the buckets. The function
-   takes in a key, pcKey, and finds the appropriate
-   bucket to insert the pcKey in. The bucket that pcKey is inserted
-   within is determined through calculation with the
-   input uBucketCount. It returns a hash code of type size_t for
-   pcKey that is between 0 and uBucketCount - 1 inclusive. */
-static size_t SymTable_hash(const char *pcKey, size_t uBucketCount) {
-   const size_t HASH_MULTIPLIER = 65599;
-   size_t u;
-   size_t uHash = 0;
+/* Takes in a full hash code, uHash, and an index to bucketArray,
+   iBucketIndex. Returns uHash modulo bucketArray[iBucketIndex].
+   Every case divides by a constant, which the compiler turns into
+   a multiplication by a precomputed reciprocal instead of a
+   division instruction. */
+static size_t SymTable_reduce(size_t uHash, int iBucketIndex) {
+   switch (iBucketIndex) {
+#define BUCKET_COUNT_CASE(index, count) \
+      case index: return uHash % (size_t)count;
+      BUCKET_COUNTS(BUCKET_COUNT_CASE)
+#undef BUCKET_COUNT_CASE
+      default:
+         /* every index to bucketArray has a case above */
+         assert(0);
+         return 0;
+   }
+}
 
-   /* ensures no null input */
+/* Takes in a Table, oSymTable, and sets the number of bindings
+   at which it grows and shrinks from its load factor and its
+   current bucket count. */
+static void SymTable_setLimits(SymTable_T oSymTable) {
+   double dGrow;
+
+   assert(oSymTable != NULL);
+
+   dGrow = oSymTable->loadFactor
+      * (double)bucketArray[oSymTable->bucketIndex];
+
+   /* never grows past the last bucket count */
+   if ((size_t)oSymTable->bucketIndex == numBucketCounts - 1
+       || dGrow >= (double)(size_t)-1)
+      oSymTable->growLimit = (size_t)-1;
+   else
+      oSymTable->growLimit = (size_t)dGrow;
+
+   /* never shrinks below the first bucket count */
+   if (oSymTable->bucketIndex == 0)
+      oSymTable->shrinkLimit = 0;
+   else
+      oSymTable->shrinkLimit = (size_t)(oSymTable->loadFactor
+         * (double)bucketArray[oSymTable->bucketIndex - 1]
+         / SHRINK_DIVISOR);
+}
+
+/* Takes in a Table, oSymTable, and a full hash code, uHash.
+   Returns the address of the bucket that holds, or would hold,
+   a key with hash code uHash. While a resize is in progress that
+   is an old bucket if it has not been moved yet. */
+static struct Binding **SymTable_bucket(SymTable_T oSymTable,
+                                        size_t uHash) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->oldBuckets != NULL) {
+      size_t uOld = SymTable_reduce(uHash, oSymTable->oldBucketIndex);
+      if (uOld >= oSymTable->migrateCursor)
+         return &oSymTable->oldBuckets[uOld];
+   }
+   return &oSymTable->buckets[SymTable_reduce(uHash,
+                                              oSymTable->bucketIndex)];
+}
+
+/* Takes in a binding, psBinding, of a Table, oSymTable, a key,
+   pcKey, its full hash code, uHash, and its length, uLength. Returns
+   1 (TRUE) if the key of psBinding is pcKey, or 0 (FALSE) otherwise.
+   The key of an atom is found by comparing addresses and lengths
+   alone. That is not done when oSymTable borrows its keys, whose
+   callers may have changed them in place. Otherwise the hash codes
+   and lengths are compared first so that most other keys are never
+   read. */
+static int SymTable_matches(SymTable_T oSymTable,
+                            const struct Binding *psBinding,
+                            const char *pcKey, size_t uHash,
+                            size_t uLength) {
+   assert(oSymTable != NULL);
+   assert(psBinding != NULL);
    assert(pcKey != NULL);
 
-   /* calulates the hash value */
-   for (u = 0; pcKey[u] != '\0'; u++)
-      uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];
+   if (psBinding->pcKey == pcKey && psBinding->uKeyLength == uLength
+       && !oSymTable->borrowedKeys)
+      return 1;
+   return psBinding->uHash == uHash
+      && psBinding->uKeyLength == uLength
+      && memcmp(psBinding->pcKey, pcKey, uLength) == 0;
+}
+
+/* Takes in a Table, oSymTable, a key, pcKey, its full hash code,
+   uHash, and its length, uLength. Returns the address of the link
+   that points to the binding whose key is pcKey. If oSymTable does
+   not contain pcKey, returns the address of the NULL link that
+   ends the chain pcKey would be in, so that the caller can add a
+   binding there without searching again. */
+static struct Binding **SymTable_find(SymTable_T oSymTable,
+                                      const char *pcKey, size_t uHash,
+                                      size_t uLength) {
+   struct Binding **ppsLink;
 
-   return uHash % uBucketCount;
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* iterates through the bucket until the binding with pcKey
+      is found or the end is reached */
+   for (ppsLink = SymTable_bucket(oSymTable, uHash);
+        *ppsLink != NULL;
+        ppsLink = &(*ppsLink)->psNextBinding) {
+      /* checks if the inputed pcKey is equal to the pcKey within
+         the bounding */
+      if (SymTable_matches(oSymTable, *ppsLink, pcKey, uHash,
+                           uLength))
+         break;
+   }
+   return ppsLink;
 }
 
-/* Takes in an SymTable_T as input, oSymTable, that will be
-   modified to increase in size. The new size will be
-   equal to the value located in the next increased index of
-   bucketArray. oSymTable will be modified to include the
-   new buckets with all of its previous bindings being
-   rehashed. oSymTable will be returned */
-static SymTable_T SymTable_resize(SymTable_T oSymTable) {
-   struct Binding **newBucket;
+/* Takes in a Table, oSymTable, and one of its bucket arrays,
+   ppsBuckets, which can be NULL. Frees ppsBuckets unless it is the
+   array inside oSymTable. */
+static void SymTable_freeBucketArray(SymTable_T oSymTable,
+                                     struct Binding **ppsBuckets) {
+   assert(oSymTable != NULL);
+
+   if (ppsBuckets != oSymTable->inlineBuckets)
+      free(ppsBuckets);
+}
+
+/* RehashJob is a structure that contains what the workers of one
+   parallel move of the bindings of a resize share */
+struct RehashJob {
+   /* the Table whose bindings are moved */
+   SymTable_T oSymTable;
+
+   /* the number of workers, which is also the number of ranges that
+      the new buckets are divided into, and the number of new
+      buckets in each range */
+   size_t uWorkers;
+   size_t uRangeSize;
+
+   /* the staging lists. The bindings that worker w took from the old
+      buckets and that belong in range r of the new buckets are
+      linked in ppsStaged[w * uWorkers + r] */
+   struct Binding **ppsStaged;
+
+   /* the next old bucket or range to take, and the end of them */
+   size_t uNext;
+   size_t uEnd;
+
+   /* the number of bindings moved */
+   size_t uMoved;
+};
+
+/* Takes in a RehashJob, pvJob, and the number of a worker,
+   uWorker. Takes REHASH_CHUNK old buckets at a time until none are
+   left, and links each of their bindings into the staging list of
+   uWorker for the range of new buckets that the binding belongs
+   in. */
+static void SymTable_stageWorker(void *pvJob, size_t uWorker) {
+   struct RehashJob *psJob = (struct RehashJob*)pvJob;
+   SymTable_T oSymTable;
+   struct Binding **ppsStaged;
+   struct Binding *psCurrentBinding;
+   struct Binding *psNextBinding;
+   size_t uFirst;
+   size_t uEnd;
+   size_t uRange;
+   /* for loop variable */
+   size_t i;
+
+   assert(psJob != NULL);
+
+   oSymTable = psJob->oSymTable;
+   ppsStaged = psJob->ppsStaged + uWorker * psJob->uWorkers;
+   for (;;) {
+      uFirst = __atomic_fetch_add(&psJob->uNext, REHASH_CHUNK,
+                                  __ATOMIC_RELAXED);
+      if (uFirst >= psJob->uEnd)
+         return;
+      uEnd = uFirst + REHASH_CHUNK;
+      if (uEnd > psJob->uEnd)
+         uEnd = psJob->uEnd;
+
+      for (i = uFirst; i < uEnd; i++)
+         for (psCurrentBinding = oSymTable->oldBuckets[i];
+              psCurrentBinding != NULL;
+              psCurrentBinding = psNextBinding) {
+            psNextBinding = psCurrentBinding->psNextBinding;
+            uRange = SymTable_reduce(psCurrentBinding->uHash,
+                                     oSymTable->bucketIndex)
+               / psJob->uRangeSize;
+            psCurrentBinding->psNextBinding = ppsStaged[uRange];
+            ppsStaged[uRange] = psCurrentBinding;
+         }
+   }
+}
+
+/* Takes in a RehashJob, pvJob, whose bindings have all been staged,
+   and the number of a worker, which is unused. Takes one range of
+   new buckets at a time until none are left, and links the
+   bindings that every worker staged for the range into their
+   buckets. No other worker changes the buckets of the range, so no
+   lock is needed. */
+static void SymTable_mergeWorker(void *pvJob, size_t uWorker) {
+   struct RehashJob *psJob = (struct RehashJob*)pvJob;
+   SymTable_T oSymTable;
    struct Binding *psCurrentBinding;
    struct Binding *psNextBinding;
+   size_t uRange;
+   size_t uMoved = 0;
    size_t hash;
    /* for loop variable */
    size_t i;
 
-   size_t newSize;
+   assert(psJob != NULL);
+   (void)uWorker;
+
+   oSymTable = psJob->oSymTable;
+   for (;;) {
+      uRange = __atomic_fetch_add(&psJob->uNext, 1, __ATOMIC_RELAXED);
+      if (uRange >= psJob->uEnd)
+         break;
+
+      for (i = 0; i < psJob->uWorkers; i++)
+         for (psCurrentBinding =
+                 psJob->ppsStaged[i * psJob->uWorkers + uRange];
+              psCurrentBinding != NULL;
+              psCurrentBinding = psNextBinding) {
+            psNextBinding = psCurrentBinding->psNextBinding;
+            hash = SymTable_reduce(psCurrentBinding->uHash,
+                                   oSymTable->bucketIndex);
+            psCurrentBinding->psNextBinding = oSymTable->buckets[hash];
+            oSymTable->buckets[hash] = psCurrentBinding;
+            uMoved++;
+         }
+   }
+   __atomic_fetch_add(&psJob->uMoved, uMoved, __ATOMIC_RELAXED);
+}
+
+/* Takes in a Table, oSymTable, whose resize is in progress, and the
+   address, puMoved, of a count. Moves every binding that has not
+   been moved yet into the new bucket array with several workers, in
+   two steps so that no two workers ever change the same list. The
+   workers first split the old buckets and stage each binding by the
+   range of new buckets that it belongs in, then split the ranges
+   and link the staged bindings into their buckets. Frees the old
+   bucket array and returns 1 (TRUE) with the number of bindings
+   moved in *puMoved. Returns 0 (FALSE) without moving any binding
+   if fewer than two workers would have old buckets to take or
+   insufficient memory is available. */
+static int SymTable_migrateParallel(SymTable_T oSymTable,
+                                    size_t *puMoved) {
+   struct RehashJob sJob;
+   size_t uOldSize;
+   size_t uWorkers;
 
-   /* ensures no null input */
    assert(oSymTable != NULL);
+   assert(oSymTable->oldBuckets != NULL);
+   assert(puMoved != NULL);
+
+   uOldSize = bucketArray[oSymTable->oldBucketIndex];
+   uWorkers = oSymTable->parallelThreads;
+   if (uWorkers == 0)
+      uWorkers = SymThreads_processorCount();
+
+   /* gives every worker at least one chunk of old buckets */
+   if (uWorkers > (uOldSize - oSymTable->migrateCursor) / REHASH_CHUNK)
+      uWorkers = (uOldSize - oSymTable->migrateCursor) / REHASH_CHUNK;
+   if (uWorkers < 2
+       || uWorkers > (size_t)-1 / sizeof(struct Binding*) / uWorkers)
+      return 0;
 
-   /* ensures that the bucketArray is not indexed out of its bounds.
-      While this is checked within the SymTable_put function it is
-      beneficial to also include here to ensure that we
-      do not try to access an array index that we do not have. */
-   if ((size_t)oSymTable->bucketIndex == numBucketCounts - 1) {
-      return oSymTable;
-   }
+   sJob.ppsStaged = (struct Binding**)
+      calloc(uWorkers * uWorkers, sizeof(struct Binding*));
+   if (sJob.ppsStaged == NULL)
+      return 0;
+   sJob.oSymTable = oSymTable;
+   sJob.uWorkers = uWorkers;
+   sJob.uRangeSize =
+      (bucketArray[oSymTable->bucketIndex] + uWorkers - 1) / uWorkers;
+   sJob.uMoved = 0;
+
+   /* stages the bindings of the old buckets that are left */
+   sJob.uNext = oSymTable->migrateCursor;
+   sJob.uEnd = uOldSize;
+   SymThreads_run(uWorkers, SymTable_stageWorker, &sJob);
+
+   /* links the staged bindings of each range into its buckets */
+   sJob.uNext = 0;
+   sJob.uEnd = uWorkers;
+   SymThreads_run(uWorkers, SymTable_mergeWorker, &sJob);
+
+   free(sJob.ppsStaged);
+   SymTable_freeBucketArray(oSymTable, oSymTable->oldBuckets);
+   oSymTable->oldBuckets = NULL;
+   oSymTable->migrateCursor = uOldSize;
+   *puMoved = sJob.uMoved;
+   return 1;
+}
 
-   /* gets the new size of the oSymTable */
-   newSize = bucketArray[oSymTable->bucketIndex + 1];
+/* Takes in a Table, oSymTable, whose resize is in progress and a
+   number of old buckets, uBuckets. Moves the bindings of up to
+   uBuckets old buckets into the new bucket array, freeing the old
+   bucket array once it is empty. Returns the number of bindings
+   moved. */
+static size_t SymTable_migrate(SymTable_T oSymTable, size_t uBuckets) {
+   struct Binding *psCurrentBinding;
+   struct Binding *psNextBinding;
+   size_t uOldSize;
+   size_t uMoved = 0;
+   size_t hash;
 
-   /* intilizes the size of newBucket to fit the
-      the new number of buckets and sets all bindings to NULL */
-   newBucket = (struct Binding**)
-      calloc(newSize, sizeof(struct Binding*));
+   assert(oSymTable != NULL);
+   assert(oSymTable->oldBuckets != NULL);
 
-   /* checks to see if calloc failed */
-   if (newBucket == NULL)
-      return oSymTable;
+   /* moves the bindings of a large Table with several threads when
+      they are all moved at once */
+   if (uBuckets == (size_t)-1
+       && oSymTable->tableInputs >= oSymTable->parallelThreshold
+       && SymTable_migrateParallel(oSymTable, &uMoved))
+      return uMoved;
 
-   /* iterates through oSymTable until the end is reached. */
-   for (i = 0; i < bucketArray[oSymTable->bucketIndex]; i++) {
-      for (psCurrentBinding = oSymTable->buckets[i];
+   uOldSize = bucketArray[oSymTable->oldBucketIndex];
+
+   for (; uBuckets > 0 && oSymTable->migrateCursor < uOldSize;
+        uBuckets--) {
+      for (psCurrentBinding =
+              oSymTable->oldBuckets[oSymTable->migrateCursor];
            psCurrentBinding != NULL;
            psCurrentBinding = psNextBinding) {
 
-         /* determines the new hash value of each binding */
-         hash = SymTable_hash(psCurrentBinding->pcKey, newSize);
+         /* determines the new bucket of each binding from its
+            stored hash code */
+         hash = SymTable_reduce(psCurrentBinding->uHash,
+                                oSymTable->bucketIndex);
 
          /* maintains access to the next binding */
          psNextBinding = psCurrentBinding->psNextBinding;
 
-         /* adds the current binding to the new correct bucket */
-         psCurrentBinding->psNextBinding = newBucket[hash];
-
          /* puts the current binding at the start of the list
             of the hashed bucket */
-         newBucket[hash] = psCurrentBinding;
+         psCurrentBinding->psNextBinding = oSymTable->buckets[hash];
+         oSymTable->buckets[hash] = psCurrentBinding;
+         uMoved++;
       }
+      oSymTable->oldBuckets[oSymTable->migrateCursor] = NULL;
+      oSymTable->migrateCursor++;
    }
 
-   /* increments bucketIndex to be the index of the new size*/
-   oSymTable->bucketIndex++;
-   
-   /* frees the old buckets memory */
-   free(oSymTable->buckets);
+   /* frees the old buckets memory once every bucket is moved */
+   if (oSymTable->migrateCursor == uOldSize) {
+      SymTable_freeBucketArray(oSymTable, oSymTable->oldBuckets);
+      oSymTable->oldBuckets = NULL;
+   }
+   return uMoved;
+}
+
+/* Takes in a Table, oSymTable, and the number of bindings, uMoved,
+   that the current call has moved between bucket arrays. Records
+   uMoved if it is the most that any call has moved. */
+static void SymTable_recordMoved(SymTable_T oSymTable, size_t uMoved) {
+   assert(oSymTable != NULL);
+
+   if (uMoved > oSymTable->stats.uMaxMoved)
+      oSymTable->stats.uMaxMoved = uMoved;
+}
+
+/* Takes in a Table, oSymTable, that is about to be used by an
+   operation. If an incremental resize is in progress, moves the
+   next MIGRATE_BUCKETS old buckets into the new bucket array. */
+static void SymTable_step(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->oldBuckets != NULL)
+      SymTable_recordMoved(oSymTable,
+                           SymTable_migrate(oSymTable,
+                                            MIGRATE_BUCKETS));
+}
+
+/* Takes in an SymTable_T as input, oSymTable, that will be
+   modified to change in size, and an index to bucketArray,
+   iNewIndex, that is usually one more or one less than its current
+   index.
+   The new size will be equal to the value located at iNewIndex of
+   bucketArray. The bindings are then moved to the new buckets,
+   all at once unless oSymTable resizes incrementally.
+   oSymTable will be returned */
+static SymTable_T SymTable_resize(SymTable_T oSymTable, int iNewIndex) {
+   struct Binding **newBucket;
+   size_t uMoved = 0;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* ensures that the bucketArray is not indexed out of its bounds.
+      While this is checked by the callers it is
+      beneficial to also include here to ensure that we
+      do not try to access an array index that we do not have. */
+   if (iNewIndex < 0 || (size_t)iNewIndex >= numBucketCounts) {
+      return oSymTable;
+   }
 
-   /* sets oSymTable->buckets to be the new buckets created */
+   /* checks that the new bucket array size does not overflow */
+   if (bucketArray[iNewIndex] > (size_t)-1 / sizeof(struct Binding*))
+      return oSymTable;
+
+   /* uses the buckets inside oSymTable for the first bucket count,
+      once a resize that is still in progress has moved every
+      binding out of them */
+   if (iNewIndex == 0) {
+      if (oSymTable->oldBuckets != NULL)
+         uMoved += SymTable_migrate(oSymTable, (size_t)-1);
+      newBucket = oSymTable->inlineBuckets;
+      memset(newBucket, 0, sizeof(oSymTable->inlineBuckets));
+   }
+   else {
+      /* intilizes the size of newBucket to fit the
+         the new number of buckets and sets all bindings to NULL */
+      newBucket = (struct Binding**)
+         calloc(bucketArray[iNewIndex], sizeof(struct Binding*));
+
+      /* checks to see if calloc failed */
+      if (newBucket == NULL)
+         return oSymTable;
+   }
+
+   /* finishes a resize that is still in progress */
+   if (oSymTable->oldBuckets != NULL)
+      uMoved += SymTable_migrate(oSymTable, (size_t)-1);
+
+   /* keeps the old buckets until all of their bindings
+      have been moved */
+   oSymTable->oldBuckets = oSymTable->buckets;
+   oSymTable->oldBucketIndex = oSymTable->bucketIndex;
+   oSymTable->migrateCursor = 0;
+
+   /* sets oSymTable->buckets to be the new buckets created and
+      bucketIndex to be the index of the new size */
    oSymTable->buckets = newBucket;
+   oSymTable->bucketIndex = iNewIndex;
+   oSymTable->stats.uResizes++;
+   SymTable_setLimits(oSymTable);
+
+   /* moves every binding now unless resizing incrementally */
+   if (!oSymTable->incremental)
+      uMoved += SymTable_migrate(oSymTable, (size_t)-1);
 
+   SymTable_recordMoved(oSymTable, uMoved);
    return oSymTable;
 }
 
-SymTable_T SymTable_new(void){
+/* Takes in an int, iRegion, that is 1 (TRUE) for a table whose
+   bindings are allocated from a region, and an int, iBorrowed, that
+   is 1 (TRUE) for a table that stores the callers' keys instead of
+   copies. Returns a new empty SymTable_T, or NULL if insufficient
+   memory is available. */
+static SymTable_T SymTable_create(int iRegion, int iBorrowed){
    SymTable_T oSymTable;
 
    /* intilizes the size of oSymTable to be the same size as
@@ -157,45 +662,119 @@ SymTable_T SymTable_new(void){
       the starting bucket size */
    oSymTable->bucketIndex = 0;
 
-   /* intilizes the size of oSymTable->buckets to fit the
-      the intial number of buckets and sets all bindings to NULL */
-   oSymTable->buckets = (struct Binding**)
-      calloc(bucketArray[0], sizeof(struct Binding*));
-
-   /* checks to see if calloc failed */
-   if (oSymTable->buckets == NULL) {
-      free(oSymTable);
-      return NULL;
-   }
+   /* starts with no resize in progress and resizing all at once */
+   oSymTable->oldBuckets = NULL;
+   oSymTable->oldBucketIndex = 0;
+   oSymTable->migrateCursor = 0;
+   oSymTable->incremental = 0;
+   oSymTable->parallelThreshold = PARALLEL_RESIZE_THRESHOLD;
+   oSymTable->parallelThreads = 0;
+   memset(&oSymTable->stats, 0, sizeof(oSymTable->stats));
+
+   /* hashes with the function from the assignment specification */
+   oSymTable->hashFunction = SYMHASH_LEGACY;
+
+   /* copies keys unless they are borrowed */
+   oSymTable->borrowedKeys = iBorrowed;
+
+   /* grows once there are more bindings than buckets */
+   oSymTable->loadFactor = 1.0;
+   SymTable_setLimits(oSymTable);
+
+   /* starts with the buckets inside oSymTable, so that no bucket
+      array is allocated until oSymTable outgrows them, and sets all
+      bindings to NULL */
+   oSymTable->buckets = oSymTable->inlineBuckets;
+   memset(oSymTable->inlineBuckets, 0,
+          sizeof(oSymTable->inlineBuckets));
+
+   /* leaves creating the allocator of the bindings to the first
+      SymTable_insert */
+   oSymTable->pool = NULL;
+   oSymTable->regionPool = iRegion;
 
    return oSymTable;
 }
 
-void SymTable_free(SymTable_T oSymTable){
+SymTable_T SymTable_new(void){
+   return SymTable_create(0, 0);
+}
+
+SymTable_T SymTable_newRegion(void){
+   return SymTable_create(1, 0);
+}
+
+SymTable_T SymTable_newBorrowedKeys(void){
+   return SymTable_create(0, 1);
+}
+
+/* Takes in a Table, oSymTable, and a binding, psBinding, that is
+   no longer linked into oSymTable. Returns the storage of psBinding
+   and its key to the allocator of oSymTable. */
+static void SymTable_freeBinding(SymTable_T oSymTable,
+                                 struct Binding *psBinding) {
+   assert(oSymTable != NULL);
+   assert(psBinding != NULL);
+
+   /* a binding that shares the key of an atom or borrows the key
+      of its caller has no copy of it */
+   if (psBinding->pcKey != psBinding->acKey) {
+      oSymTable->stats.uSharedKeyBytes -= psBinding->uKeyLength + 1;
+      SymPool_release(oSymTable->pool, psBinding,
+                      sizeof(struct Binding));
+   }
+   else
+      SymPool_release(oSymTable->pool, psBinding,
+                      sizeof(struct Binding) + psBinding->uKeyLength
+                      + 1);
+}
+
+/* Takes in a Table, oSymTable, one of its arrays of buckets,
+   ppsBuckets, and its size, uBucketCount. Frees every binding in
+   ppsBuckets. */
+static void SymTable_freeBuckets(SymTable_T oSymTable,
+                                 struct Binding **ppsBuckets,
+                                 size_t uBucketCount) {
    struct Binding *psCurrentBinding;
    struct Binding *psNextBinding;
    /* for loop variable */
    size_t i;
 
-   /* ensures no null input */
-   assert(oSymTable != NULL);
-
-   /* iterates through oSymTable freeing all memory */
-   for (i = 0; i < bucketArray[oSymTable->bucketIndex]; i++) {
-      for (psCurrentBinding = oSymTable->buckets[i];
+   for (i = 0; i < uBucketCount; i++) {
+      for (psCurrentBinding = ppsBuckets[i];
            psCurrentBinding != NULL;
            psCurrentBinding = psNextBinding) {
          /* maintains access to the next binding */
          psNextBinding = psCurrentBinding->psNextBinding;
 
-         /* frees all memory wihtin the binding */
-         free((void *) psCurrentBinding->pcKey);
-         free(psCurrentBinding);
+         /* frees the binding along with its key */
+         SymTable_freeBinding(oSymTable, psCurrentBinding);
       }
    }
-   /* frees the memory created for the oSymTable structure
-      and the buckets */
-   free(oSymTable->buckets);
+}
+
+void SymTable_free(SymTable_T oSymTable){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* iterates through oSymTable freeing all memory, unless the
+      bindings are in a region that SymPool_free releases at once.
+      Moved old buckets are empty. */
+   if (oSymTable->pool == NULL || !SymPool_isRegion(oSymTable->pool)) {
+      SymTable_freeBuckets(oSymTable, oSymTable->buckets,
+                           bucketArray[oSymTable->bucketIndex]);
+      if (oSymTable->oldBuckets != NULL)
+         SymTable_freeBuckets(oSymTable, oSymTable->oldBuckets,
+                              bucketArray[oSymTable->oldBucketIndex]);
+   }
+   SymTable_freeBucketArray(oSymTable, oSymTable->oldBuckets);
+
+   /* frees the memory created for the oSymTable structure, the
+      buckets and the slabs of the bindings, if any binding was ever
+      inserted */
+   if (oSymTable->pool != NULL)
+      SymPool_free(oSymTable->pool);
+   SymTable_freeBucketArray(oSymTable, oSymTable->buckets);
    free(oSymTable);
 }
 
@@ -207,247 +786,1127 @@ size_t SymTable_getLength(SymTable_T oSymTable){
    return oSymTable->tableInputs;
 }
 
-int SymTable_put(SymTable_T oSymTable, const char *pcKey,
-                 const void *pvValue) {
+/* Takes in a Table, oSymTable, the NULL link, ppsLink, that ends
+   the chain a key, pcKey, belongs in, along with its full hash
+   code, uHash, its length, uLength, and a value, pvValue. Adds a
+   binding with a defensive copy of pcKey and pvValue at ppsLink,
+   then grows oSymTable if it is too full. If iShared is 1 (TRUE),
+   pcKey outlives the binding, which stores pcKey itself instead
+   of a copy. Returns the new binding, or NULL leaving oSymTable
+   unchanged if insufficient memory is available. */
+static struct Binding *SymTable_insert(SymTable_T oSymTable,
+                                       struct Binding **ppsLink,
+                                       const char *pcKey, size_t uHash,
+                                       size_t uLength, int iShared,
+                                       const void *pvValue) {
    struct Binding *psNewBinding;
-   char *pcKeySave;
-   size_t hash;
+   size_t uSize = sizeof(struct Binding);
 
-   /* ensures no null input where unexpected.
-      pvValue can be NULL */
    assert(oSymTable != NULL);
+   assert(ppsLink != NULL);
+   assert(*ppsLink == NULL);
    assert(pcKey != NULL);
 
-   /* checks if oSymTable already contains pcKey */
-   if(SymTable_contains(oSymTable, pcKey)){
-      /* returns 0 representing that pcKey was already found within
-         oSymTable so no new binding was added*/
-      return 0;
+   /* creates the allocator of the bindings for the first binding */
+   if (oSymTable->pool == NULL) {
+      if (oSymTable->regionPool)
+         oSymTable->pool = SymPool_newRegion();
+      else
+         oSymTable->pool = SymPool_new();
+
+      /* checks to see if SymPool_new failed */
+      if (oSymTable->pool == NULL)
+         return NULL;
    }
 
-   /* allocates memory for which the new Binding will reside */
-   psNewBinding = (struct Binding*)malloc(sizeof(struct Binding));
+   /* allocates memory for which the new Binding and its defensive
+      key will reside */
+   if (!iShared)
+      uSize += uLength + 1;
+   psNewBinding = (struct Binding*)SymPool_alloc(oSymTable->pool,
+                                                 uSize);
 
-   /* checks to see if malloc failed */
+   /* checks to see if SymPool_alloc failed */
    if (psNewBinding == NULL)
-      /* returns 0 representing that their was
+      /* returns NULL representing that their was
          insufficeint memory */
-      return 0;
-
-   /* allocates memory for which the defensive key will reside */
-   pcKeySave = malloc(strlen(pcKey) + 1);
+      return NULL;
 
-   /* checks to see if malloc failed */
-   if (pcKeySave == NULL) {
-      free(psNewBinding);
-      /* returns 0 representing that their was
-         insufficeint memory */
-      return 0;
+   /* copies the key into the binding allowing a defensive copy to
+      be stored, unless the key is shared */
+   if (iShared) {
+      psNewBinding->pcKey = pcKey;
+      oSymTable->stats.uSharedKeyBytes += uLength + 1;
+   }
+   else {
+      memcpy(psNewBinding->acKey, pcKey, uLength);
+      psNewBinding->acKey[uLength] = '\0';
+      psNewBinding->pcKey = psNewBinding->acKey;
    }
 
-   /* copies the key into allocated memory allowing a
-      defensive copy to be stored */
-   strcpy(pcKeySave, pcKey);
+   /* saves the value, hash code and key length into the binding */
+   psNewBinding->pvValue = (void*)pvValue;
+   psNewBinding->uHash = uHash;
+   psNewBinding->uKeyLength = uLength;
+
+   /* sets the last binding within the chain to be the binding
+      just created */
+   psNewBinding->psNextBinding = NULL;
+   *ppsLink = psNewBinding;
 
    /* increments the number of inputs stored in oSymTable */
    oSymTable->tableInputs++;
 
-   /* checks if oSymtable needs to be resized. This also checks to
-      see if we have reached the max number of buckets
-      preventing SymTable_resize from being called for every binding
-      inserted after the table has already reached its max length */
-   if ((oSymTable->tableInputs
-        > bucketArray[oSymTable->bucketIndex])
-       && ((size_t)oSymTable->bucketIndex != numBucketCounts - 1)){
+   /* checks if oSymtable needs to grow. The grow limit is never
+      reached once the max number of buckets is in use, preventing
+      SymTable_resize from being called for every binding inserted
+      after the table has already reached its max length. The new
+      binding is moved along with all the others. */
+   if (oSymTable->tableInputs > oSymTable->growLimit){
       /* attempts to resize if enough memory is availiable */
-      oSymTable = SymTable_resize(oSymTable);
+      oSymTable = SymTable_resize(oSymTable,
+                                  oSymTable->bucketIndex + 1);
+   }
+
+   return psNewBinding;
+}
+
+/* Takes in a Table, oSymTable, a key, pcKey, its full hash code,
+   uHash, its length, uLength, and a value, pvValue. Searches for
+   pcKey once. If pcKey is not found, adds a binding of pcKey and
+   pvValue, which shares pcKey if iShared is 1 (TRUE), and sets
+   *piInserted to 1. Otherwise sets *piInserted to 0 and, if
+   iReplace is 1, replaces the binding's value with pvValue.
+   Returns the address of the binding's value, or NULL with
+   *piInserted set to 0 if insufficient memory is available. */
+static void **SymTable_upsertHashed(SymTable_T oSymTable,
+                                    const char *pcKey, size_t uHash,
+                                    size_t uLength, int iShared,
+                                    const void *pvValue, int iReplace,
+                                    int *piInserted) {
+   struct Binding **ppsLink;
+   struct Binding *psBinding;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+   assert(piInserted != NULL);
+
+   /* counts puts that run while a resize is in progress */
+   if (oSymTable->oldBuckets != NULL)
+      oSymTable->stats.uMigrationPuts++;
+   SymTable_step(oSymTable);
+
+   /* searches for pcKey, keeping the end of its chain */
+   ppsLink = SymTable_find(oSymTable, pcKey, uHash, uLength);
+   *piInserted = 0;
+
+   if (*ppsLink != NULL) {
+      psBinding = *ppsLink;
+      if (iReplace)
+         psBinding->pvValue = (void*)pvValue;
    }
+   else {
+      psBinding = SymTable_insert(oSymTable, ppsLink, pcKey, uHash,
+                                  uLength, iShared, pvValue);
+      if (psBinding == NULL)
+         return NULL;
+      *piInserted = 1;
+   }
+   return &psBinding->pvValue;
+}
 
-   /* calculates the hash value to determine which bucket
-      the binding will be inserted in */
-   hash = SymTable_hash(pcKey,
-                        bucketArray[oSymTable->bucketIndex]);
+/* Takes in a Table, oSymTable, a key, pcKey, and a value, pvValue.
+   Hashes pcKey and adds or finds its binding as
+   SymTable_upsertHashed does, copying pcKey unless oSymTable
+   borrows its keys. */
+static void **SymTable_upsertKey(SymTable_T oSymTable,
+                                 const char *pcKey,
+                                 const void *pvValue, int iReplace,
+                                 int *piInserted) {
+   size_t uHash;
+   size_t uLength;
 
-   /* saves the value and defensive key into the binding */
-   psNewBinding->pvValue = pvValue;
-   psNewBinding->pcKey = pcKeySave;
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
 
-   /* sets the first binding within the oSymTable bucket
-      to be the binding just created */
-   psNewBinding->psNextBinding = oSymTable->buckets[hash];
-   oSymTable->buckets[hash] = psNewBinding;
+   uHash = SymHash_hashString(oSymTable->hashFunction, pcKey,
+                              &uLength);
+   return SymTable_upsertHashed(oSymTable, pcKey, uHash, uLength,
+                                oSymTable->borrowedKeys, pvValue,
+                                iReplace, piInserted);
+}
 
-   return 1;
+int SymTable_put(SymTable_T oSymTable, const char *pcKey,
+                 const void *pvValue) {
+   int iInserted;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* adds the binding only if pcKey is not found, returning 0
+      if pcKey was already found or insufficient memory is
+      available */
+   SymTable_upsertKey(oSymTable, pcKey, pvValue, 0, &iInserted);
+   return iInserted;
+}
+
+void **SymTable_upsert(SymTable_T oSymTable, const char *pcKey,
+                       const void *pvValue, int *piInserted){
+   int iInserted;
+
+   /* ensures no null input where unexpected.
+      pvValue and piInserted can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   if (piInserted == NULL)
+      piInserted = &iInserted;
+   return SymTable_upsertKey(oSymTable, pcKey, pvValue, 1,
+                             piInserted);
+}
+
+void **SymTable_getOrPut(SymTable_T oSymTable, const char *pcKey,
+                         const void *pvValue, int *piInserted){
+   int iInserted;
+
+   /* ensures no null input where unexpected.
+      pvValue and piInserted can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   if (piInserted == NULL)
+      piInserted = &iInserted;
+   return SymTable_upsertKey(oSymTable, pcKey, pvValue, 0,
+                             piInserted);
 }
 
 void *SymTable_replace(SymTable_T oSymTable, const char *pcKey,
                        const void *pvValue){
-   struct Binding *psCurrentBinding;
-   size_t hash;
+   struct Binding **ppsLink;
+   void *pvValueSave;
+   size_t uHash;
+   size_t uLength;
 
    /* ensures no null input where unexpected.
       pvValue can be NULL */
    assert(oSymTable != NULL);
    assert(pcKey != NULL);
 
-   /* calculates the hash value to determine which bucket
-      to search within */
-   hash = SymTable_hash(pcKey, bucketArray[oSymTable->bucketIndex]);
+   SymTable_step(oSymTable);
 
-   /* iterates through the oSymTable bucket until the binding
-      with pcKey is found or the end is reached */
-   for (psCurrentBinding = oSymTable->buckets[hash];
-        psCurrentBinding != NULL;
-        psCurrentBinding = psCurrentBinding->psNextBinding) {
-      /* checks if the inputed pcKey is equal to the pcKey within
-         the bounding */
-      if (strcmp(psCurrentBinding->pcKey, pcKey) == 0) {
-         /* replaces the binding's value with pvValue */
-         const void *pvValueSave = psCurrentBinding->pvValue;
-         psCurrentBinding->pvValue = pvValue;
+   /* searches for the binding with pcKey */
+   uHash = SymHash_hashString(oSymTable->hashFunction, pcKey,
+                              &uLength);
+   ppsLink = SymTable_find(oSymTable, pcKey, uHash, uLength);
+   if (*ppsLink == NULL)
+      return NULL;
 
-         /* returns the old pvValue */
-         return (void*)pvValueSave;
-      }
-   }
-   return NULL;
+   /* replaces the binding's value with pvValue */
+   pvValueSave = (*ppsLink)->pvValue;
+   (*ppsLink)->pvValue = (void*)pvValue;
+
+   /* returns the old pvValue */
+   return pvValueSave;
 }
 
 int SymTable_contains(SymTable_T oSymTable, const char *pcKey){
-   struct Binding *psCurrentBinding;
-   size_t hash;
+   size_t uHash;
+   size_t uLength;
 
    /* ensures no null input */
    assert(oSymTable != NULL);
    assert(pcKey != NULL);
 
-   /* calculates the hash value to determine which bucket
-      to search within */
-   hash = SymTable_hash(pcKey, bucketArray[oSymTable->bucketIndex]);
-
-   /* iterates through the oSymTable bucket until the binding
-      with pcKey is found or the end is reached */
-   for (psCurrentBinding = oSymTable->buckets[hash];
-        psCurrentBinding != NULL;
-        psCurrentBinding = psCurrentBinding->psNextBinding) {
-      /* checks if the inputed pcKey is equal to the pcKey within
-         the bounding */
-      if (strcmp(psCurrentBinding->pcKey, pcKey) == 0)
-         /* returns 1 representing that pcKey was found */
-         return 1;
-   }
-   /* returns 0 representing that pcKey was not found */
-   return 0;
+   SymTable_step(oSymTable);
 
+   /* returns 1 if pcKey was found and 0 otherwise */
+   uHash = SymHash_hashString(oSymTable->hashFunction, pcKey,
+                              &uLength);
+   return *SymTable_find(oSymTable, pcKey, uHash, uLength) != NULL;
 }
 
 void *SymTable_get(SymTable_T oSymTable, const char *pcKey){
-   struct Binding *psCurrentBinding;
-   size_t hash;
+   struct Binding **ppsLink;
+   size_t uHash;
+   size_t uLength;
 
    /* ensures no null input */
    assert(oSymTable != NULL);
    assert(pcKey != NULL);
 
-   /* calculates the hash value to determine which bucket
-      to search within */
-   hash = SymTable_hash(pcKey, bucketArray[oSymTable->bucketIndex]);
+   SymTable_step(oSymTable);
 
-   /* iterates through the oSymTable bucket until the binding
-      with pcKey is found or the end is reached */
-   for (psCurrentBinding = oSymTable->buckets[hash];
-        psCurrentBinding != NULL;
-        psCurrentBinding = psCurrentBinding->psNextBinding) {
-      /* checks if the inputed pcKey is equal to the pcKey within
-         the bounding */
-      if (strcmp(psCurrentBinding->pcKey, pcKey) == 0)
-         /* returns the binding of the binding whose key is pcKey */
-         return (void*)psCurrentBinding->pvValue;
-   }
-   /* returns NULL representing that no such binding exists*/
-   return NULL;
+   /* searches for the binding with pcKey */
+   uHash = SymHash_hashString(oSymTable->hashFunction, pcKey,
+                              &uLength);
+   ppsLink = SymTable_find(oSymTable, pcKey, uHash, uLength);
+   if (*ppsLink == NULL)
+      /* returns NULL representing that no such binding exists*/
+      return NULL;
+
+   /* returns the binding of the binding whose key is pcKey */
+   return (*ppsLink)->pvValue;
 }
 
-void *SymTable_remove(SymTable_T oSymTable, const char *pcKey){
+/* Takes in a Table, oSymTable, a key, pcKey, its full hash code,
+   uHash, and its length, uLength. Removes the binding with pcKey
+   from oSymTable, shrinking oSymTable if it has become too empty,
+   and returns the binding's value. Returns NULL leaving oSymTable
+   unchanged if oSymTable does not contain pcKey. */
+static void *SymTable_removeHashed(SymTable_T oSymTable,
+                                   const char *pcKey, size_t uHash,
+                                   size_t uLength) {
+   struct Binding **ppsLink;
    struct Binding *psCurrentBinding;
-   struct Binding *psPreviousBinding;
-   size_t hash;
+   void *bindingValue;
 
-   /* ensures no null input */
    assert(oSymTable != NULL);
    assert(pcKey != NULL);
 
-   /* calculates the hash value to determine which bucket
-      to search within */
-   hash = SymTable_hash(pcKey, bucketArray[oSymTable->bucketIndex]);
+   SymTable_step(oSymTable);
+
+   /* searches for the binding with pcKey */
+   ppsLink = SymTable_find(oSymTable, pcKey, uHash, uLength);
+   if (*ppsLink == NULL)
+      return NULL;
 
-   psPreviousBinding = NULL;
+   /* removes the current binding by linking the previous
+      binding, or the bucket, with the next binding */
+   psCurrentBinding = *ppsLink;
+   *ppsLink = psCurrentBinding->psNextBinding;
 
-   /* iterates through the oSymTable bucket until the binding
-      with pcKey is found or the end is reached */
-   for (psCurrentBinding = oSymTable->buckets[hash];
-        psCurrentBinding != NULL;
-        psCurrentBinding = psCurrentBinding->psNextBinding) {
-      /* checks if the inputed pcKey is equal to the pcKey within
-         the bounding */
-      if (strcmp(psCurrentBinding->pcKey, pcKey) == 0) {
-         const void *bindingValue;
-
-         /* checks to see if the previous binding is NULL
-            representing that this is the first binding
-            in oSymTable */
-         if (psPreviousBinding == NULL) {
-            /* updates the first binding withing oSymTable to
-               be the one immediately following the first*/
-            oSymTable->buckets[hash]
-               = psCurrentBinding->psNextBinding;
-         }
-         else {
-            /* removes the current binding by linking the previous
-               binding with the next binding */
-            psPreviousBinding->psNextBinding =
-               psCurrentBinding->psNextBinding;
-         }
-         /* stores the removed bindings value */
-         bindingValue = psCurrentBinding->pvValue;
+   /* stores the removed bindings value */
+   bindingValue = psCurrentBinding->pvValue;
+
+   /* decrements the number of inputs within oSymTable */
+   oSymTable->tableInputs--;
 
-         /* decrements the number of inputs within oSymTable */
-         oSymTable->tableInputs--;
+   /* frees the current binding along with its key */
+   SymTable_freeBinding(oSymTable, psCurrentBinding);
 
-         /* frees all memory within the current binding */
-         free((void *)psCurrentBinding->pcKey);
-         free(psCurrentBinding);
+   /* checks if oSymTable has few enough bindings to shrink and
+      release most of its buckets */
+   if (oSymTable->tableInputs < oSymTable->shrinkLimit)
+      oSymTable = SymTable_resize(oSymTable,
+                                  oSymTable->bucketIndex - 1);
+
+   return bindingValue;
+}
 
-         return (void*)bindingValue;
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey){
+   size_t uHash;
+   size_t uLength;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* removes the binding with pcKey if there is one */
+   uHash = SymHash_hashString(oSymTable->hashFunction, pcKey,
+                              &uLength);
+   return SymTable_removeHashed(oSymTable, pcKey, uHash, uLength);
+}
+
+/* Takes in an array of buckets, ppsBuckets, and the range of
+   buckets from uFirst up to but not including uEnd. Applies
+   function *pfApply to each binding in that range, passing
+   pvExtra as an extra argument. */
+static void SymTable_mapBuckets(struct Binding **ppsBuckets,
+                                size_t uFirst, size_t uEnd,
+                                void (*pfApply) (const char *pcKey,
+                                                 void *pvValue,
+                                                 void *pvExtra),
+                                const void *pvExtra) {
+   struct Binding *psCurrentBinding;
+   /* for loop variable */
+   size_t i;
+
+   for (i = uFirst; i < uEnd; i++) {
+      for (psCurrentBinding = ppsBuckets[i];
+           psCurrentBinding != NULL;
+           psCurrentBinding = psCurrentBinding->psNextBinding) {
+         /* applies function *pfApply to each binding in
+            oSymtable passing pvExtra as an extra parameter*/
+         (*pfApply)(psCurrentBinding->pcKey,
+                    psCurrentBinding->pvValue,
+                    (void*)pvExtra);
       }
-      psPreviousBinding = psCurrentBinding;
    }
-   return NULL;
 }
 
 void SymTable_map(SymTable_T oSymTable,
                   void (*pfApply) (const char *pcKey, void
                                    *pvValue, void *pvExtra),
                   const void *pvExtra){
+   /* ensures no null input where unexpected.
+      pvExtra can be NULL */
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   /* iterates through oSymTable until the end is reached, including
+      the old buckets that have not been moved yet */
+   SymTable_mapBuckets(oSymTable->buckets, 0,
+                       bucketArray[oSymTable->bucketIndex],
+                       pfApply, pvExtra);
+   if (oSymTable->oldBuckets != NULL)
+      SymTable_mapBuckets(oSymTable->oldBuckets,
+                          oSymTable->migrateCursor,
+                          bucketArray[oSymTable->oldBucketIndex],
+                          pfApply, pvExtra);
+}
+
+void SymTable_iterBegin(SymTable_T oSymTable,
+                        struct SymTable_Iter *psIter){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(psIter != NULL);
+
+   /* finishes a resize that is still in progress, so that searches
+      during the scan never move bindings */
+   if (oSymTable->oldBuckets != NULL)
+      SymTable_recordMoved(oSymTable,
+                           SymTable_migrate(oSymTable, (size_t)-1));
+
+   /* starts before the first binding of the first bucket */
+   psIter->uBucket = 0;
+   psIter->pvBinding = NULL;
+}
+
+int SymTable_iterNext(SymTable_T oSymTable,
+                      struct SymTable_Iter *psIter,
+                      const char **ppcKey, void **ppvValue){
    struct Binding *psCurrentBinding;
+   size_t uBucketCount;
+
+   /* ensures no null input where unexpected.
+      ppcKey and ppvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(psIter != NULL);
+
+   /* no resize has started since SymTable_iterBegin, since no
+      binding has been added or removed */
+   assert(oSymTable->oldBuckets == NULL);
+
+   /* moves on to the next bucket that is not empty once the
+      bindings of the current bucket are used up */
+   psCurrentBinding = (struct Binding*)psIter->pvBinding;
+   uBucketCount = bucketArray[oSymTable->bucketIndex];
+   while (psCurrentBinding == NULL) {
+      if (psIter->uBucket >= uBucketCount)
+         return 0;
+      psCurrentBinding = oSymTable->buckets[psIter->uBucket];
+      psIter->uBucket++;
+   }
+
+   /* returns the current binding and moves past it */
+   psIter->pvBinding = psCurrentBinding->psNextBinding;
+   if (ppcKey != NULL)
+      *ppcKey = psCurrentBinding->pcKey;
+   if (ppvValue != NULL)
+      *ppvValue = psCurrentBinding->pvValue;
+   return 1;
+}
+
+/* MapJob is a structure that contains what the workers of one
+   SymTable_mapReduce call share */
+struct MapJob {
+   /* the Table whose bindings are visited */
+   SymTable_T oSymTable;
+
+   /* the function applied to each binding */
+   void (*pfApply) (const char *pcKey, void *pvValue, void *pvLocal);
+
+   /* the argument that each worker passes to pfApply */
+   void **ppvLocals;
+
+   /* the next bucket to take, counting the buckets of
+      oSymTable->buckets and then the old buckets that have not been
+      moved yet, and the number of buckets in all */
+   size_t uNextBucket;
+   size_t uBucketCount;
+};
+
+/* Takes in a MapJob, pvJob, and the number of a worker, uWorker.
+   Takes chunks of buckets from the MapJob until none are left,
+   applying its function to each binding in them. */
+static void SymTable_mapWorker(void *pvJob, size_t uWorker) {
+   struct MapJob *psJob = (struct MapJob*)pvJob;
+   SymTable_T oSymTable;
+   size_t uFirst;
+   size_t uEnd;
+   size_t uNewCount;
+
+   assert(psJob != NULL);
+
+   oSymTable = psJob->oSymTable;
+   uNewCount = bucketArray[oSymTable->bucketIndex];
+   for (;;) {
+      uFirst = __atomic_fetch_add(&psJob->uNextBucket, MAP_CHUNK,
+                                  __ATOMIC_RELAXED);
+      if (uFirst >= psJob->uBucketCount)
+         return;
+      uEnd = uFirst + MAP_CHUNK;
+      if (uEnd > psJob->uBucketCount)
+         uEnd = psJob->uBucketCount;
+
+      /* splits a chunk that ends in the old buckets */
+      if (uFirst < uNewCount)
+         SymTable_mapBuckets(oSymTable->buckets, uFirst,
+                             uEnd < uNewCount ? uEnd : uNewCount,
+                             psJob->pfApply,
+                             psJob->ppvLocals[uWorker]);
+      if (uEnd > uNewCount)
+         SymTable_mapBuckets(oSymTable->oldBuckets,
+                             oSymTable->migrateCursor
+                             + (uFirst > uNewCount ?
+                                uFirst - uNewCount : 0),
+                             oSymTable->migrateCursor
+                             + (uEnd - uNewCount),
+                             psJob->pfApply,
+                             psJob->ppvLocals[uWorker]);
+   }
+}
+
+void SymTable_mapReduce(SymTable_T oSymTable,
+                        void (*pfApply) (const char *pcKey,
+                                         void *pvValue,
+                                         void *pvLocal),
+                        void *(*pfBegin) (void *pvExtra),
+                        void (*pfEnd) (void *pvLocal, void *pvExtra),
+                        void *pvExtra, size_t uThreads){
+   struct MapJob sJob;
+   void *pvOnlyLocal;
+   size_t uWorkers;
    /* for loop variable */
    size_t i;
 
+   /* ensures no null input where unexpected.
+      pfBegin, pfEnd and pvExtra can be NULL */
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   if (uThreads == 0)
+      uThreads = SymThreads_processorCount();
+
+   /* gives each worker its own argument for pfApply, or pvExtra
+      itself if there is no pfBegin. Without the memory for the
+      arguments, the calling thread visits every binding */
+   sJob.ppvLocals = NULL;
+   if (uThreads <= (size_t)-1 / sizeof(void*))
+      sJob.ppvLocals = (void**)malloc(uThreads * sizeof(void*));
+   if (sJob.ppvLocals == NULL) {
+      uThreads = 1;
+      sJob.ppvLocals = &pvOnlyLocal;
+   }
+   for (i = 0; i < uThreads; i++)
+      sJob.ppvLocals[i] = (pfBegin != NULL) ? (*pfBegin)(pvExtra)
+         : pvExtra;
+
+   /* visits the buckets and then the old buckets that have not
+      been moved yet, one chunk at a time */
+   sJob.oSymTable = oSymTable;
+   sJob.pfApply = pfApply;
+   sJob.uNextBucket = 0;
+   sJob.uBucketCount = bucketArray[oSymTable->bucketIndex];
+   if (oSymTable->oldBuckets != NULL)
+      sJob.uBucketCount += bucketArray[oSymTable->oldBucketIndex]
+         - oSymTable->migrateCursor;
+   uWorkers = uThreads;
+   if (uWorkers > sJob.uBucketCount / MAP_CHUNK + 1)
+      uWorkers = sJob.uBucketCount / MAP_CHUNK + 1;
+   SymThreads_run(uWorkers, SymTable_mapWorker, &sJob);
+
+   /* combines the arguments of the workers in order */
+   if (pfEnd != NULL)
+      for (i = 0; i < uThreads; i++)
+         (*pfEnd)(sJob.ppvLocals[i], pvExtra);
+   if (sJob.ppvLocals != &pvOnlyLocal)
+      free(sJob.ppvLocals);
+}
+
+void SymTable_mapParallel(SymTable_T oSymTable,
+                          void (*pfApply) (const char *pcKey,
+                                           void *pvValue,
+                                           void *pvExtra),
+                          const void *pvExtra, size_t uThreads){
    /* ensures no null input where unexpected.
       pvExtra can be NULL */
    assert(oSymTable != NULL);
    assert(pfApply != NULL);
 
-   /* iterates through oSymTable until the end is reached */
-   for (i = 0; i <  bucketArray[oSymTable->bucketIndex]; i++) {
+   SymTable_mapReduce(oSymTable, pfApply, NULL, NULL, (void*)pvExtra,
+                      uThreads);
+}
+
+void SymTable_setIncrementalResize(SymTable_T oSymTable, int iEnabled){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   oSymTable->incremental = iEnabled;
+}
+
+void SymTable_setParallelResize(SymTable_T oSymTable,
+                                size_t uThreshold, size_t uThreads){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   oSymTable->parallelThreshold = uThreshold;
+   oSymTable->parallelThreads = uThreads;
+}
+
+void SymTable_setLoadFactor(SymTable_T oSymTable, double dLoadFactor){
+   /* ensures no null input and a positive load factor */
+   assert(oSymTable != NULL);
+   assert(dLoadFactor > 0);
+
+   oSymTable->loadFactor = dLoadFactor;
+   SymTable_setLimits(oSymTable);
+}
+
+void SymTable_setHashFunction(SymTable_T oSymTable,
+                              enum SymHash_Function eFunction){
+   struct Binding *psBindings = NULL;
+   struct Binding *psCurrentBinding;
+   struct Binding *psNextBinding;
+   struct Binding **ppsBucket;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   if (eFunction == oSymTable->hashFunction)
+      return;
+   oSymTable->hashFunction = eFunction;
+
+   /* finishes a resize that is still in progress */
+   if (oSymTable->oldBuckets != NULL)
+      SymTable_recordMoved(oSymTable,
+                           SymTable_migrate(oSymTable, (size_t)-1));
+
+   /* unlinks every binding into one list */
+   for (i = 0; i < bucketArray[oSymTable->bucketIndex]; i++) {
       for (psCurrentBinding = oSymTable->buckets[i];
            psCurrentBinding != NULL;
-           psCurrentBinding = psCurrentBinding->psNextBinding) {
-         /* applies function *pfApply to each binding in
-            oSymtable passing pvExtra as an extra parameter*/
-         (*pfApply)(psCurrentBinding->pcKey,
-                    (void*)psCurrentBinding->pvValue,
-                    (void*)pvExtra);
+           psCurrentBinding = psNextBinding) {
+         psNextBinding = psCurrentBinding->psNextBinding;
+         psCurrentBinding->psNextBinding = psBindings;
+         psBindings = psCurrentBinding;
+      }
+      oSymTable->buckets[i] = NULL;
+   }
+
+   /* rehashes every key with the new function and puts its binding
+      at the start of the list of the hashed bucket */
+   for (psCurrentBinding = psBindings; psCurrentBinding != NULL;
+        psCurrentBinding = psNextBinding) {
+      psNextBinding = psCurrentBinding->psNextBinding;
+      psCurrentBinding->uHash =
+         SymHash_hash(eFunction, psCurrentBinding->pcKey,
+                      psCurrentBinding->uKeyLength);
+      ppsBucket = SymTable_bucket(oSymTable, psCurrentBinding->uHash);
+      psCurrentBinding->psNextBinding = *ppsBucket;
+      *ppsBucket = psCurrentBinding;
+   }
+}
+
+void SymTable_getChainLengths(SymTable_T oSymTable, size_t auCounts[],
+                              size_t uCountsLength){
+   struct Binding *psCurrentBinding;
+   size_t uLength;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(auCounts != NULL);
+   assert(uCountsLength > 0);
+
+   memset(auCounts, 0, uCountsLength * sizeof(size_t));
+
+   /* finishes a resize that is still in progress so that every
+      binding is in the current buckets */
+   if (oSymTable->oldBuckets != NULL)
+      SymTable_recordMoved(oSymTable,
+                           SymTable_migrate(oSymTable, (size_t)-1));
+
+   /* counts the bindings of every bucket, adding the longest
+      chains to the last count */
+   for (i = 0; i < bucketArray[oSymTable->bucketIndex]; i++) {
+      uLength = 0;
+      for (psCurrentBinding = oSymTable->buckets[i];
+           psCurrentBinding != NULL;
+           psCurrentBinding = psCurrentBinding->psNextBinding)
+         uLength++;
+      if (uLength >= uCountsLength)
+         uLength = uCountsLength - 1;
+      auCounts[uLength]++;
+   }
+}
+
+void SymTable_getStats(SymTable_T oSymTable,
+                       struct SymTable_Stats *psStats){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(psStats != NULL);
+
+   *psStats = oSymTable->stats;
+   if (oSymTable->pool != NULL)
+      SymPool_getCounts(oSymTable->pool,
+                        &psStats->uBindingAllocations,
+                        &psStats->uBindingReuses);
+   else {
+      psStats->uBindingAllocations = 0;
+      psStats->uBindingReuses = 0;
+   }
+}
+
+/* Takes in a Table, oSymTable, and a key, pcKey, of length
+   uLength whose full hash code for the hash function eFunction is
+   uHash. Returns the full hash code of pcKey for the hash function
+   of oSymTable, which is uHash unless the functions differ. */
+static size_t SymTable_hashFor(SymTable_T oSymTable,
+                               enum SymHash_Function eFunction,
+                               size_t uHash, const char *pcKey,
+                               size_t uLength) {
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   if (oSymTable->hashFunction == eFunction)
+      return uHash;
+   return SymHash_hash(oSymTable->hashFunction, pcKey, uLength);
+}
+
+/* the table that SymTable_intern stores every atom in. Each atom is
+   one of its bindings, which never move and are never removed, and
+   whose cached hash code is that of SYMHASH_LEGACY. No lock guards
+   it, so only one thread at a time may call SymTable_intern */
+static SymTable_T atomTable = NULL;
+
+SymAtom_T SymTable_intern(const char *pcKey){
+   struct Binding **ppsLink;
+   struct Binding *psBinding;
+   size_t uHash;
+   size_t uLength;
+
+   /* ensures no null input */
+   assert(pcKey != NULL);
+
+   /* creates the atom table on the first call */
+   if (atomTable == NULL) {
+      atomTable = SymTable_new();
+      if (atomTable == NULL)
+         return NULL;
+   }
+
+   /* searches for the atom of pcKey, adding it if it is not found */
+   uHash = SymHash_hashString(SYMHASH_LEGACY, pcKey, &uLength);
+   ppsLink = SymTable_find(atomTable, pcKey, uHash, uLength);
+   psBinding = *ppsLink;
+   if (psBinding == NULL)
+      psBinding = SymTable_insert(atomTable, ppsLink, pcKey, uHash,
+                                  uLength, 0, NULL);
+   return (SymAtom_T)(void *)psBinding;
+}
+
+const char *SymTable_atomKey(SymAtom_T oAtom){
+   /* ensures no null input */
+   assert(oAtom != NULL);
+
+   return ((struct Binding *)(void *)oAtom)->pcKey;
+}
+
+/* Takes in a Table, oSymTable, and an atom, psAtom. Returns the full
+   hash code of the key of psAtom for the hash function of
+   oSymTable, which is cached unless oSymTable has changed it. */
+static size_t SymTable_atomHash(SymTable_T oSymTable,
+                                const struct Binding *psAtom) {
+   assert(oSymTable != NULL);
+   assert(psAtom != NULL);
+
+   return SymTable_hashFor(oSymTable, SYMHASH_LEGACY, psAtom->uHash,
+                           psAtom->pcKey, psAtom->uKeyLength);
+}
+
+int SymTable_putAtom(SymTable_T oSymTable, SymAtom_T oAtom,
+                     const void *pvValue){
+   const struct Binding *psAtom = (struct Binding *)(void *)oAtom;
+   int iInserted;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(oAtom != NULL);
+
+   /* adds a binding that shares the key of the atom only if the key
+      is not found */
+   SymTable_upsertHashed(oSymTable, psAtom->pcKey,
+                         SymTable_atomHash(oSymTable, psAtom),
+                         psAtom->uKeyLength, 1, pvValue, 0,
+                         &iInserted);
+   return iInserted;
+}
+
+void *SymTable_getAtom(SymTable_T oSymTable, SymAtom_T oAtom){
+   const struct Binding *psAtom = (struct Binding *)(void *)oAtom;
+   struct Binding **ppsLink;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(oAtom != NULL);
+
+   SymTable_step(oSymTable);
+
+   /* searches for the binding with the key of the atom, whose
+      address matches unless the binding was put with a copy */
+   ppsLink = SymTable_find(oSymTable, psAtom->pcKey,
+                           SymTable_atomHash(oSymTable, psAtom),
+                           psAtom->uKeyLength);
+   if (*ppsLink == NULL)
+      /* returns NULL representing that no such binding exists*/
+      return NULL;
+
+   return (*ppsLink)->pvValue;
+}
+
+SymTable_Key SymTable_makeKey(const char *pcKey){
+   SymTable_Key sKey;
+
+   /* ensures no null input */
+   assert(pcKey != NULL);
+
+   /* hashes pcKey once with the default hash function */
+   sKey.pcKey = pcKey;
+   sKey.eFunction = SYMHASH_LEGACY;
+   sKey.uHash = SymHash_hashString(SYMHASH_LEGACY, pcKey,
+                                   &sKey.uLength);
+   return sKey;
+}
+
+int SymTable_putK(SymTable_T oSymTable, SymTable_Key sKey,
+                  const void *pvValue){
+   int iInserted;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(sKey.pcKey != NULL);
+
+   /* adds a binding with a copy of the key, unless oSymTable
+      borrows its keys, only if the key is not found */
+   SymTable_upsertHashed(oSymTable, sKey.pcKey,
+                         SymTable_hashFor(oSymTable, sKey.eFunction,
+                                          sKey.uHash, sKey.pcKey,
+                                          sKey.uLength),
+                         sKey.uLength, oSymTable->borrowedKeys,
+                         pvValue, 0, &iInserted);
+   return iInserted;
+}
+
+int SymTable_containsK(SymTable_T oSymTable, SymTable_Key sKey){
+   size_t uHash;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(sKey.pcKey != NULL);
+
+   SymTable_step(oSymTable);
+
+   /* returns 1 if the key was found and 0 otherwise */
+   uHash = SymTable_hashFor(oSymTable, sKey.eFunction, sKey.uHash,
+                            sKey.pcKey, sKey.uLength);
+   return *SymTable_find(oSymTable, sKey.pcKey, uHash, sKey.uLength)
+      != NULL;
+}
+
+void *SymTable_getK(SymTable_T oSymTable, SymTable_Key sKey){
+   struct Binding **ppsLink;
+   size_t uHash;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(sKey.pcKey != NULL);
+
+   SymTable_step(oSymTable);
+
+   /* searches for the binding with the key. The bucket is found
+      from the full hash code and the current bucket count, so the
+      key stays valid across resizes */
+   uHash = SymTable_hashFor(oSymTable, sKey.eFunction, sKey.uHash,
+                            sKey.pcKey, sKey.uLength);
+   ppsLink = SymTable_find(oSymTable, sKey.pcKey, uHash,
+                           sKey.uLength);
+   if (*ppsLink == NULL)
+      /* returns NULL representing that no such binding exists*/
+      return NULL;
+
+   return (*ppsLink)->pvValue;
+}
+
+void *SymTable_removeK(SymTable_T oSymTable, SymTable_Key sKey){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(sKey.pcKey != NULL);
+
+   /* removes the binding with the key if there is one */
+   return SymTable_removeHashed(oSymTable, sKey.pcKey,
+                                SymTable_hashFor(oSymTable,
+                                                 sKey.eFunction,
+                                                 sKey.uHash,
+                                                 sKey.pcKey,
+                                                 sKey.uLength),
+                                sKey.uLength);
+}
+
+/* Takes in a Table, oSymTable, and a key, pcKey, of uLength
+   characters. Returns the binding with pcKey, or NULL if oSymTable
+   does not contain pcKey. */
+static struct Binding *SymTable_lookupN(SymTable_T oSymTable,
+                                        const char *pcKey,
+                                        size_t uLength) {
+   size_t uHash;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   SymTable_step(oSymTable);
+
+   uHash = SymHash_hash(oSymTable->hashFunction, pcKey, uLength);
+   return *SymTable_find(oSymTable, pcKey, uHash, uLength);
+}
+
+int SymTable_putN(SymTable_T oSymTable, const char *pcKey,
+                  size_t uLength, const void *pvValue){
+   int iInserted;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* adds a binding with a copy of the uLength characters only if
+      they are not found. They are copied even if oSymTable borrows
+      its keys, because they need not be followed by '\0' */
+   SymTable_upsertHashed(oSymTable, pcKey,
+                         SymHash_hash(oSymTable->hashFunction, pcKey,
+                                      uLength),
+                         uLength, 0, pvValue, 0, &iInserted);
+   return iInserted;
+}
+
+void *SymTable_replaceN(SymTable_T oSymTable, const char *pcKey,
+                        size_t uLength, const void *pvValue){
+   struct Binding *psBinding;
+   void *pvValueSave;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psBinding = SymTable_lookupN(oSymTable, pcKey, uLength);
+   if (psBinding == NULL)
+      return NULL;
+
+   /* replaces the binding's value with pvValue and returns the old
+      one */
+   pvValueSave = psBinding->pvValue;
+   psBinding->pvValue = (void*)pvValue;
+   return pvValueSave;
+}
+
+int SymTable_containsN(SymTable_T oSymTable, const char *pcKey,
+                       size_t uLength){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* returns 1 if the key was found and 0 otherwise */
+   return SymTable_lookupN(oSymTable, pcKey, uLength) != NULL;
+}
+
+void *SymTable_getN(SymTable_T oSymTable, const char *pcKey,
+                    size_t uLength){
+   struct Binding *psBinding;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psBinding = SymTable_lookupN(oSymTable, pcKey, uLength);
+   if (psBinding == NULL)
+      /* returns NULL representing that no such binding exists*/
+      return NULL;
+
+   return psBinding->pvValue;
+}
+
+void *SymTable_removeN(SymTable_T oSymTable, const char *pcKey,
+                       size_t uLength){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* removes the binding with the key if there is one */
+   return SymTable_removeHashed(oSymTable, pcKey,
+                                SymHash_hash(oSymTable->hashFunction,
+                                             pcKey, uLength),
+                                uLength);
+}
+
+size_t SymTable_putBatch(SymTable_T oSymTable,
+                         const char *const apcKeys[],
+                         const void *const apvValues[],
+                         size_t uCount, int aiResults[]){
+   size_t auHashes[BATCH_CHUNK];
+   size_t auLengths[BATCH_CHUNK];
+   struct Binding **ppsLink;
+   size_t uNeeded;
+   size_t uAdded = 0;
+   size_t uFirst;
+   size_t uChunk;
+   int iNewIndex;
+   int iInserted;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input where unexpected.
+      aiResults can be NULL */
+   assert(oSymTable != NULL);
+   assert(uCount == 0 || apcKeys != NULL);
+   assert(uCount == 0 || apvValues != NULL);
+
+   /* sizes the bucket array once for all of the keys, as if none
+      of them were in oSymTable yet */
+   uNeeded = oSymTable->tableInputs + uCount;
+   iNewIndex = oSymTable->bucketIndex;
+   while ((size_t)iNewIndex < numBucketCounts - 1
+          && oSymTable->loadFactor * (double)bucketArray[iNewIndex]
+             < (double)uNeeded)
+      iNewIndex++;
+   if (iNewIndex != oSymTable->bucketIndex)
+      oSymTable = SymTable_resize(oSymTable, iNewIndex);
+
+   /* finishes any resize in progress so that every key is linked
+      into the current bucket array */
+   if (oSymTable->oldBuckets != NULL)
+      SymTable_recordMoved(oSymTable,
+                           SymTable_migrate(oSymTable, (size_t)-1));
+
+   for (uFirst = 0; uFirst < uCount; uFirst += uChunk) {
+      uChunk = uCount - uFirst;
+      if (uChunk > BATCH_CHUNK)
+         uChunk = BATCH_CHUNK;
+
+      /* hashes every key of the chunk in one pass, prefetching the
+         bucket that each one belongs in */
+      for (i = 0; i < uChunk; i++) {
+         assert(apcKeys[uFirst + i] != NULL);
+         auHashes[i] = SymHash_hashString(oSymTable->hashFunction,
+                                          apcKeys[uFirst + i],
+                                          &auLengths[i]);
+         SYMTABLE_PREFETCH(SymTable_bucket(oSymTable, auHashes[i]));
+      }
+
+      /* links every key of the chunk, prefetching the first binding
+         of a bucket PREFETCH_DISTANCE keys ahead */
+      for (i = 0; i < uChunk; i++) {
+         if (i + PREFETCH_DISTANCE < uChunk)
+            SYMTABLE_PREFETCH(
+               *SymTable_bucket(oSymTable,
+                                auHashes[i + PREFETCH_DISTANCE]));
+
+         ppsLink = SymTable_find(oSymTable, apcKeys[uFirst + i],
+                                 auHashes[i], auLengths[i]);
+         if (*ppsLink != NULL)
+            iInserted = 0;
+         else
+            iInserted = SymTable_insert(oSymTable, ppsLink,
+                                        apcKeys[uFirst + i],
+                                        auHashes[i], auLengths[i],
+                                        oSymTable->borrowedKeys,
+                                        apvValues[uFirst + i])
+               != NULL;
+         if (aiResults != NULL)
+            aiResults[uFirst + i] = iInserted;
+         uAdded += (size_t)iInserted;
+      }
+   }
+   return uAdded;
+}
+
+size_t SymTable_getMany(SymTable_T oSymTable,
+                        const char *const apcKeys[], size_t uCount,
+                        void *apvValues[]){
+   size_t auHashes[BATCH_CHUNK];
+   size_t auLengths[BATCH_CHUNK];
+   struct Binding **appsBuckets[BATCH_CHUNK];
+   struct Binding *apsCursors[BATCH_CHUNK];
+   size_t auActive[BATCH_CHUNK];
+   size_t uActiveCount;
+   size_t uStillActive;
+   size_t uFound = 0;
+   size_t uFirst;
+   size_t uChunk;
+   size_t uKey;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(uCount == 0 || apcKeys != NULL);
+   assert(uCount == 0 || apvValues != NULL);
+
+   SymTable_step(oSymTable);
+
+   for (uFirst = 0; uFirst < uCount; uFirst += uChunk) {
+      uChunk = uCount - uFirst;
+      if (uChunk > BATCH_CHUNK)
+         uChunk = BATCH_CHUNK;
+
+      /* hashes every key of the chunk, prefetching its bucket */
+      for (i = 0; i < uChunk; i++) {
+         assert(apcKeys[uFirst + i] != NULL);
+         auHashes[i] = SymHash_hashString(oSymTable->hashFunction,
+                                          apcKeys[uFirst + i],
+                                          &auLengths[i]);
+         appsBuckets[i] = SymTable_bucket(oSymTable, auHashes[i]);
+         SYMTABLE_PREFETCH(appsBuckets[i]);
+      }
+
+      /* reads the first binding of every bucket, prefetching it */
+      for (i = 0; i < uChunk; i++) {
+         apsCursors[i] = *appsBuckets[i];
+         SYMTABLE_PREFETCH(apsCursors[i]);
+         auActive[i] = i;
+      }
+
+      /* advances every chain that is still being searched by one
+         binding per round, so that the cache misses of all of them
+         overlap, until each key is found or its chain ends */
+      for (uActiveCount = uChunk; uActiveCount > 0;
+           uActiveCount = uStillActive) {
+         uStillActive = 0;
+         for (i = 0; i < uActiveCount; i++) {
+            uKey = auActive[i];
+            if (apsCursors[uKey] == NULL)
+               apvValues[uFirst + uKey] = NULL;
+            else if (SymTable_matches(oSymTable, apsCursors[uKey],
+                                      apcKeys[uFirst + uKey],
+                                      auHashes[uKey],
+                                      auLengths[uKey])) {
+               apvValues[uFirst + uKey] = apsCursors[uKey]->pvValue;
+               uFound++;
+            }
+            else {
+               apsCursors[uKey] = apsCursors[uKey]->psNextBinding;
+               SYMTABLE_PREFETCH(apsCursors[uKey]);
+               auActive[uStillActive++] = uKey;
+            }
+         }
       }
    }
+   return uFound;
 }
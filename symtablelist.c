@@ -5,18 +5,20 @@
 #include <stdlib.h>
 #include <string.h>
 #include "symtable.h"
+#include "sympool.h"
 
 /* Each item is stored in a Binding.
    Bindings are linked to form a Table*/
 struct Binding {
    /* stores the value of the binding */
-   const void *pvValue;
-
-   /* stores the key of the binding */
-   const char *pcKey;
+   void *pvValue;
 
    /* The address of the next Binding*/
    struct Binding *psNextBinding;
+
+   /* stores the defensive copy of the key of the binding, which is
+      allocated together with the binding */
+   char acKey[];
 };
 
 /* Table is a structure that points to the
@@ -29,9 +31,16 @@ struct Table {
    /* The number of elements contained within
       the Table */
    size_t tableInputs;
+
+   /* the allocator of the bindings, which reuses the storage of
+      removed bindings */
+   SymPool_T pool;
 };
 
-SymTable_T SymTable_new(void){
+/* Takes in an int, iRegion, that is 1 (TRUE) for a table whose
+   bindings are allocated from a region. Returns a new empty
+   SymTable_T, or NULL if insufficient memory is available. */
+static SymTable_T SymTable_create(int iRegion){
    SymTable_T oSymTable;
 
    /* intilizes the size of oSymTable to be the same size as
@@ -50,9 +59,42 @@ SymTable_T SymTable_new(void){
       an empty SymTable_T */
    oSymTable->tableInputs = 0;
 
+   /* creates the allocator of the bindings */
+   if (iRegion)
+      oSymTable->pool = SymPool_newRegion();
+   else
+      oSymTable->pool = SymPool_new();
+
+   /* checks to see if SymPool_new failed */
+   if (oSymTable->pool == NULL) {
+      free(oSymTable);
+      return NULL;
+   }
+
    return oSymTable;
 }
 
+SymTable_T SymTable_new(void){
+   return SymTable_create(0);
+}
+
+SymTable_T SymTable_newRegion(void){
+   return SymTable_create(1);
+}
+
+/* Takes in a Table, oSymTable, and a binding, psBinding, that is
+   no longer linked into oSymTable. Returns the storage of psBinding
+   and its key to the allocator of oSymTable. */
+static void SymTable_freeBinding(SymTable_T oSymTable,
+                                 struct Binding *psBinding) {
+   assert(oSymTable != NULL);
+   assert(psBinding != NULL);
+
+   SymPool_release(oSymTable->pool, psBinding,
+                   sizeof(struct Binding) + strlen(psBinding->acKey)
+                   + 1);
+}
+
 void SymTable_free(SymTable_T oSymTable){
    struct Binding *psCurrentBinding;
    struct Binding *psNextBinding;
@@ -60,18 +102,22 @@ void SymTable_free(SymTable_T oSymTable){
    /* ensures no null input */
    assert(oSymTable != NULL);
 
-   /* iterates through oSymTable freeing all memory */
-   for (psCurrentBinding = oSymTable->psFirstBinding;
-        psCurrentBinding != NULL;
-        psCurrentBinding = psNextBinding) {
-      /* maintains access to the next binding */
-      psNextBinding = psCurrentBinding->psNextBinding;
-
-      /* frees all memory wihtin the binding */
-      free((void *)psCurrentBinding->pcKey);
-      free(psCurrentBinding);
+   /* iterates through oSymTable freeing all memory, unless the
+      bindings are in a region that SymPool_free releases at once */
+   if (!SymPool_isRegion(oSymTable->pool)) {
+      for (psCurrentBinding = oSymTable->psFirstBinding;
+           psCurrentBinding != NULL;
+           psCurrentBinding = psNextBinding) {
+         /* maintains access to the next binding */
+         psNextBinding = psCurrentBinding->psNextBinding;
+
+         /* frees the binding along with its key */
+         SymTable_freeBinding(oSymTable, psCurrentBinding);
+      }
    }
-   /* frees the memory created for the oSymTable structure */
+   /* frees the memory created for the oSymTable structure and the
+      slabs of the bindings */
+   SymPool_free(oSymTable->pool);
    free(oSymTable);
 }
 
@@ -83,60 +129,116 @@ size_t SymTable_getLength(SymTable_T oSymTable){
    return oSymTable->tableInputs;
 }
 
+/* Takes in a Table, oSymTable, a key, pcKey, and a value, pvValue.
+   Searches oSymTable for pcKey once. If pcKey is not found, adds a
+   binding of pcKey and pvValue and sets *piInserted to 1.
+   Otherwise sets *piInserted to 0 and, if iReplace is 1, replaces
+   the binding's value with pvValue. Returns the address of the
+   binding's value, or NULL with *piInserted set to 0 if
+   insufficient memory is available. */
+static void **SymTable_upsertKey(SymTable_T oSymTable,
+                                 const char *pcKey,
+                                 const void *pvValue, int iReplace,
+                                 int *piInserted) {
+   struct Binding *psCurrentBinding;
+   struct Binding *psNewBinding;
+   size_t uKeySize;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+   assert(piInserted != NULL);
+
+   *piInserted = 0;
+
+   /* iterates through oSymTable until the binding with pcKey is
+      found or the end is reached */
+   for (psCurrentBinding = oSymTable->psFirstBinding;
+        psCurrentBinding != NULL;
+        psCurrentBinding = psCurrentBinding->psNextBinding) {
+      /* checks if the inputed pcKey is equal to the pcKey within
+         the bounding */
+      if (strcmp(psCurrentBinding->acKey, pcKey) == 0) {
+         if (iReplace)
+            psCurrentBinding->pvValue = (void*)pvValue;
+         return &psCurrentBinding->pvValue;
+      }
+   }
+
+   /* allocates memory for which the new Binding and its defensive
+      key will reside */
+   uKeySize = strlen(pcKey) + 1;
+   psNewBinding = (struct Binding*)
+      SymPool_alloc(oSymTable->pool, sizeof(struct Binding) + uKeySize);
+
+   /* checks to see if SymPool_alloc failed */
+   if (psNewBinding == NULL)
+      /* returns NULL representing that their was
+         insufficeint memory */
+      return NULL;
+
+   /* copies the key into the binding allowing a defensive copy to
+      be stored */
+   memcpy(psNewBinding->acKey, pcKey, uKeySize);
+
+   /* saves the value into the binding */
+   psNewBinding->pvValue = (void*)pvValue;
+
+   /* sets the first binding within oSymTable to be the binding
+      just created */
+   psNewBinding->psNextBinding = oSymTable->psFirstBinding;
+   oSymTable->psFirstBinding = psNewBinding;
+
+   /* increments the number of inputs stored in oSymTable */
+   oSymTable->tableInputs++;
+
+   *piInserted = 1;
+   return &psNewBinding->pvValue;
+}
+
 int SymTable_put(SymTable_T oSymTable, const char *pcKey,
                  const void *pvValue){
+   int iInserted;
+
    /* ensures no null input where unexpected.
       pvValue can be NULL */
    assert(oSymTable != NULL);
    assert(pcKey != NULL);
 
-   /* checks if oSymTable already contains pcKey */
-   if(!SymTable_contains(oSymTable, pcKey)){
-      struct Binding *psNewBinding;
-      char *pcKeySave;
-
-      /* allocates memory for which the new Binding will reside */
-      psNewBinding = (struct Binding*)malloc(sizeof(struct Binding));
-
-      /* checks to see if malloc failed */
-      if (psNewBinding == NULL)
-         /* returns 0 representing that their was
-            insufficeint memory */
-         return 0;
-
-      /* allocates memory for which the defensive key will reside */
-      pcKeySave = malloc(strlen(pcKey) + 1);
-
-      /* checks to see if malloc failed */
-      if (pcKeySave == NULL) {
-         free(psNewBinding);
-         /* returns 0 representing that their was
-            insufficeint memory */
-         return 0;
-      }
+   /* adds the binding only if pcKey is not found, returning 0
+      if pcKey was already found or insufficient memory is
+      available */
+   SymTable_upsertKey(oSymTable, pcKey, pvValue, 0, &iInserted);
+   return iInserted;
+}
 
-      /* copies the key into allocated memory allowing a
-         defensive copy to be stored */
-      strcpy(pcKeySave, pcKey);
+void **SymTable_upsert(SymTable_T oSymTable, const char *pcKey,
+                       const void *pvValue, int *piInserted){
+   int iInserted;
 
-      /* saves the value and defensive key into the binding */
-      psNewBinding->pvValue = pvValue;
-      psNewBinding->pcKey = pcKeySave;
+   /* ensures no null input where unexpected.
+      pvValue and piInserted can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
 
-      /* sets the first binding within oSymTable to be the binding
-         just created */
-      psNewBinding->psNextBinding = oSymTable->psFirstBinding;
-      oSymTable->psFirstBinding = psNewBinding;
+   if (piInserted == NULL)
+      piInserted = &iInserted;
+   return SymTable_upsertKey(oSymTable, pcKey, pvValue, 1,
+                             piInserted);
+}
 
-      /* increments the number of inputs stored in oSymTable */
-      oSymTable->tableInputs++;
+void **SymTable_getOrPut(SymTable_T oSymTable, const char *pcKey,
+                         const void *pvValue, int *piInserted){
+   int iInserted;
 
-      /* returns 1 representing that a new binding was added*/
-      return 1;
-   }
-   /* returns 0 representing that pcKey was already found within
-      oSymTable so no new binding was added*/
-   return 0;
+   /* ensures no null input where unexpected.
+      pvValue and piInserted can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   if (piInserted == NULL)
+      piInserted = &iInserted;
+   return SymTable_upsertKey(oSymTable, pcKey, pvValue, 0,
+                             piInserted);
 }
 
 void *SymTable_replace(SymTable_T oSymTable, const char *pcKey,
@@ -156,13 +258,13 @@ void *SymTable_replace(SymTable_T oSymTable, const char *pcKey,
 
       /* checks if the inputed pcKey is equal to the pcKey within
          the bounding */
-      if (strcmp(psCurrentBinding->pcKey, pcKey) == 0) {
+      if (strcmp(psCurrentBinding->acKey, pcKey) == 0) {
          /* replaces the binding's value with pvValue */
-         const void *pvValueSave = psCurrentBinding->pvValue;
-         psCurrentBinding->pvValue = pvValue;
+         void *pvValueSave = psCurrentBinding->pvValue;
+         psCurrentBinding->pvValue = (void*)pvValue;
 
          /* returns the old pvValue */
-         return (void*)pvValueSave;
+         return pvValueSave;
       }
    }
    return NULL;
@@ -182,7 +284,7 @@ int SymTable_contains(SymTable_T oSymTable, const char *pcKey){
         psCurrentBinding = psCurrentBinding->psNextBinding) {
       /* checks if the inputed pcKey is equal to the pcKey within
          the bounding */
-      if (strcmp(psCurrentBinding->pcKey, pcKey) == 0)
+      if (strcmp(psCurrentBinding->acKey, pcKey) == 0)
          /* returns 1 representing that pcKey was found */
          return 1;
    }
@@ -204,9 +306,9 @@ void *SymTable_get(SymTable_T oSymTable, const char *pcKey){
         psCurrentBinding = psCurrentBinding->psNextBinding) {
       /* checks if the inputed pcKey is equal to the pcKey within
          the bounding */
-      if (strcmp(psCurrentBinding->pcKey, pcKey) == 0)
+      if (strcmp(psCurrentBinding->acKey, pcKey) == 0)
          /* returns the binding of the binding whose key is pcKey */
-         return (void*)psCurrentBinding->pvValue;
+         return psCurrentBinding->pvValue;
    }
    /* returns NULL representing that no such binding exists*/
    return NULL;
@@ -229,8 +331,8 @@ void *SymTable_remove(SymTable_T oSymTable, const char *pcKey){
         psCurrentBinding = psCurrentBinding->psNextBinding) {
       /* checks if the inputed pcKey is equal to the pcKey within
          the bounding */
-      if (strcmp(psCurrentBinding->pcKey, pcKey) == 0) {
-         const void *bindingValue;
+      if (strcmp(psCurrentBinding->acKey, pcKey) == 0) {
+         void *bindingValue;
 
          /* checks to see if the previous binding is NULL
             representing that this is the first binding
@@ -253,11 +355,10 @@ void *SymTable_remove(SymTable_T oSymTable, const char *pcKey){
          /* decrements the number of inputs within oSymTable */
          oSymTable->tableInputs--;
 
-         /* frees all memory within the current binding */
-         free((void *)psCurrentBinding->pcKey);
-         free(psCurrentBinding);
+         /* frees the current binding along with its key */
+         SymTable_freeBinding(oSymTable, psCurrentBinding);
 
-         return (void*)bindingValue;
+         return bindingValue;
       }
       psPreviousBinding = psCurrentBinding;
    }
@@ -282,8 +383,55 @@ void SymTable_map(SymTable_T oSymTable,
 
       /* applies function *pfApply to each binding in oSymtable
          passing pvExtra as an extra parameter*/
-      (*pfApply)(psCurrentBinding->pcKey,
-                 (void*)psCurrentBinding->pvValue,
+      (*pfApply)(psCurrentBinding->acKey,
+                 psCurrentBinding->pvValue,
                  (void*)pvExtra);
    }
 }
+
+void SymTable_iterBegin(SymTable_T oSymTable,
+                        struct SymTable_Iter *psIter){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(psIter != NULL);
+
+   /* starts with the first binding. The list has no buckets */
+   psIter->uBucket = 0;
+   psIter->pvBinding = oSymTable->psFirstBinding;
+}
+
+int SymTable_iterNext(SymTable_T oSymTable,
+                      struct SymTable_Iter *psIter,
+                      const char **ppcKey, void **ppvValue){
+   struct Binding *psCurrentBinding;
+
+   /* ensures no null input where unexpected.
+      ppcKey and ppvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(psIter != NULL);
+
+   /* checks if the end of oSymTable was reached */
+   psCurrentBinding = (struct Binding*)psIter->pvBinding;
+   if (psCurrentBinding == NULL)
+      return 0;
+
+   /* returns the current binding and moves past it */
+   psIter->pvBinding = psCurrentBinding->psNextBinding;
+   if (ppcKey != NULL)
+      *ppcKey = psCurrentBinding->acKey;
+   if (ppvValue != NULL)
+      *ppvValue = psCurrentBinding->pvValue;
+   return 1;
+}
+
+void SymTable_getStats(SymTable_T oSymTable,
+                       struct SymTable_Stats *psStats){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(psStats != NULL);
+
+   /* a linked list never resizes */
+   memset(psStats, 0, sizeof(*psStats));
+   SymPool_getCounts(oSymTable->pool, &psStats->uBindingAllocations,
+                     &psStats->uBindingReuses);
+}
@@ -0,0 +1,606 @@
+/* implements the SymTable Robin Hood open addressing version */
+
+/* includes libraries*/
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "symtable.h"
+
+/* the x86 SIMD probes are compiled with per function target
+   attributes and only used when the CPU reports support for them.
+   Compiling with -DSYMTABLE_NO_SIMD forces the scalar probe. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+   && !defined(SYMTABLE_NO_SIMD)
+#include <immintrin.h>
+#define SYMTABLE_X86_SIMD
+#endif
+
+/* the number of slots a new Table starts with. The number of
+   slots is always a power of two so that a home slot can be
+   found with a shift instead of a division */
+enum {INITIAL_SLOT_COUNT = 16};
+
+/* the log base 2 of INITIAL_SLOT_COUNT */
+enum {INITIAL_SLOT_BITS = 4};
+
+/* the Table is grown once more than
+   MAX_LOAD_NUMERATOR / MAX_LOAD_DENOMINATOR of its slots are used */
+enum {MAX_LOAD_NUMERATOR = 7, MAX_LOAD_DENOMINATOR = 8};
+
+/* the most tags a probe compares at once. The tag array is this
+   many bytes minus one longer than the slot array, and the extra
+   bytes mirror the first tags so a probe never has to wrap */
+enum {MAX_GROUP_WIDTH = 32};
+
+/* the tag stored for an empty slot. Occupied slots have the high
+   bit of their tag set */
+enum {EMPTY_TAG = 0};
+
+/* Type of a probe function. It compares the tags starting at
+   pucTags with ucTag and returns a bit mask with bit i set if tag
+   i matched. It also stores in *puEmpty a bit mask with bit i set
+   if tag i was EMPTY_TAG. */
+typedef uint32_t (*SymTable_Probe)(const unsigned char *pucTags,
+                                   unsigned char ucTag,
+                                   uint32_t *puEmpty);
+
+/* Each item is stored in a Slot. Slots are stored inline in
+   one flat array, so a lookup never follows a pointer until
+   it compares keys */
+struct Slot {
+   /* stores the key of the binding, or NULL if the
+      slot is empty */
+   const char *pcKey;
+
+   /* stores the value of the binding */
+   const void *pvValue;
+
+   /* stores the full hash code of the key so that resizing and
+      probing never need to rehash or compare most keys */
+   size_t uHash;
+};
+
+/* Table is a structure that contains the flat array of Slots.
+   It also stores the number of elements contained within the
+   Table and the log base 2 of the number of slots */
+struct Table {
+   /* The number of elements contained within
+      the Table */
+   size_t tableInputs;
+
+   /* the flat array of slots */
+   struct Slot *slots;
+
+   /* one byte per slot holding EMPTY_TAG or 7 bits of the slot's
+      hash code, followed by MAX_GROUP_WIDTH - 1 mirrored tags */
+   unsigned char *tags;
+
+   /* the largest distance any binding has been stored from its
+      home slot since the slots were last grown */
+   size_t maxDistance;
+
+   /* the log base 2 of the number of slots */
+   int slotBits;
+};
+
+/* the probe selected for this CPU and the number of tags it
+   compares at once. They are chosen by SymTable_selectProbe. */
+static SymTable_Probe pfProbe = NULL;
+static size_t uProbeWidth = 0;
+
+/* Takes in a bit mask, uMask, that is not 0 and returns the
+   index of its lowest set bit. */
+static size_t SymTable_lowestBit(uint32_t uMask) {
+   assert(uMask != 0);
+#ifdef __GNUC__
+   return (size_t)__builtin_ctz(uMask);
+#else
+   {
+      size_t u = 0;
+      while ((uMask & 1) == 0) {
+         uMask >>= 1;
+         u++;
+      }
+      return u;
+   }
+#endif
+}
+
+/* Scalar probe that compares 8 tags one at a time. See
+   SymTable_Probe. */
+static uint32_t SymTable_probeScalar(const unsigned char *pucTags,
+                                     unsigned char ucTag,
+                                     uint32_t *puEmpty) {
+   uint32_t uMatch = 0;
+   uint32_t uEmpty = 0;
+   /* for loop variable */
+   size_t i;
+
+   for (i = 0; i < 8; i++) {
+      if (pucTags[i] == ucTag)
+         uMatch |= (uint32_t)1 << i;
+      if (pucTags[i] == EMPTY_TAG)
+         uEmpty |= (uint32_t)1 << i;
+   }
+   *puEmpty = uEmpty;
+   return uMatch;
+}
+
+#ifdef SYMTABLE_X86_SIMD
+/* SSE2 probe that compares 16 tags with one instruction. See
+   SymTable_Probe. */
+__attribute__((target("sse2")))
+static uint32_t SymTable_probeSse2(const unsigned char *pucTags,
+                                   unsigned char ucTag,
+                                   uint32_t *puEmpty) {
+   __m128i mTags = _mm_loadu_si128((const __m128i *)pucTags);
+
+   *puEmpty = (uint32_t)_mm_movemask_epi8(
+      _mm_cmpeq_epi8(mTags, _mm_set1_epi8((char)EMPTY_TAG)));
+   return (uint32_t)_mm_movemask_epi8(
+      _mm_cmpeq_epi8(mTags, _mm_set1_epi8((char)ucTag)));
+}
+
+/* AVX2 probe that compares 32 tags with one instruction. See
+   SymTable_Probe. */
+__attribute__((target("avx2")))
+static uint32_t SymTable_probeAvx2(const unsigned char *pucTags,
+                                   unsigned char ucTag,
+                                   uint32_t *puEmpty) {
+   __m256i mTags = _mm256_loadu_si256((const __m256i *)pucTags);
+
+   *puEmpty = (uint32_t)_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(mTags, _mm256_set1_epi8((char)EMPTY_TAG)));
+   return (uint32_t)_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(mTags, _mm256_set1_epi8((char)ucTag)));
+}
+#endif
+
+/* Selects the widest probe that the running CPU supports. */
+static void SymTable_selectProbe(void) {
+   pfProbe = SymTable_probeScalar;
+   uProbeWidth = 8;
+#ifdef SYMTABLE_X86_SIMD
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2")) {
+      pfProbe = SymTable_probeAvx2;
+      uProbeWidth = 32;
+   }
+   else if (__builtin_cpu_supports("sse2")) {
+      pfProbe = SymTable_probeSse2;
+      uProbeWidth = 16;
+   }
+#endif
+}
+
+/* Hash function that takes in a key, pcKey, and returns its
+   full width hash code of type size_t. This is the hash function
+   from the assignment specification, shared with the hash table
+   implementation, before it is reduced to a slot. */
+static size_t SymTable_hash(const char *pcKey) {
+   size_t uLength;
+
+   /* ensures no null input */
+   assert(pcKey != NULL);
+
+   return SymHash_hashString(SYMHASH_LEGACY, pcKey, &uLength);
+}
+
+/* Takes in a full hash code, uHash, and the log base 2 of the
+   number of slots, iSlotBits. Returns the home slot of uHash,
+   which is between 0 and 2^iSlotBits - 1 inclusive. The
+   multiplicative (Fibonacci) step spreads the low quality low
+   bits of uHash over the whole slot range. */
+static size_t SymTable_home(size_t uHash, int iSlotBits) {
+   const uint64_t FIBONACCI_MULTIPLIER = UINT64_C(0x9E3779B97F4A7C15);
+
+   return (size_t)(((uint64_t)uHash * FIBONACCI_MULTIPLIER)
+                   >> (64 - iSlotBits));
+}
+
+/* Takes in a full hash code, uHash, and the log base 2 of the
+   number of slots, iSlotBits. Returns the tag of uHash: the 7
+   bits just below the ones SymTable_home uses, with the high bit
+   set so that it never equals EMPTY_TAG. */
+static unsigned char SymTable_tag(size_t uHash, int iSlotBits) {
+   const uint64_t FIBONACCI_MULTIPLIER = UINT64_C(0x9E3779B97F4A7C15);
+
+   return (unsigned char)(0x80 | ((((uint64_t)uHash
+                                    * FIBONACCI_MULTIPLIER)
+                                   >> (57 - iSlotBits)) & 0x7F));
+}
+
+/* Takes in the Table, oSymTable, the index of a slot, uIndex, and
+   a tag, ucTag. Stores ucTag as the tag of slot uIndex and in
+   every mirrored copy of it. */
+static void SymTable_setTag(SymTable_T oSymTable, size_t uIndex,
+                            unsigned char ucTag) {
+   size_t uCount = (size_t)1 << oSymTable->slotBits;
+
+   oSymTable->tags[uIndex] = ucTag;
+   for (; uIndex < MAX_GROUP_WIDTH - 1; uIndex += uCount)
+      oSymTable->tags[uCount + uIndex] = ucTag;
+}
+
+/* Takes in the Table, oSymTable, and the index, uIndex, of an
+   occupied slot. Returns how far that slot is from the home
+   slot of the key it holds. */
+static size_t SymTable_distance(SymTable_T oSymTable, size_t uIndex) {
+   size_t uMask = ((size_t)1 << oSymTable->slotBits) - 1;
+   size_t uHome = SymTable_home(oSymTable->slots[uIndex].uHash,
+                                oSymTable->slotBits);
+
+   return (uIndex - uHome) & uMask;
+}
+
+/* Takes in a Table, oSymTable, a key, pcKey, and its full hash
+   code, uHash. Returns the index of the slot holding pcKey, or
+   the number of slots if pcKey is not within oSymTable. The tags
+   of a whole group of slots are compared at once, and only slots
+   whose tag matches have their keys compared. The search stops
+   at the first empty slot, or once it is further from the home
+   slot than any binding has been stored. */
+static size_t SymTable_find(SymTable_T oSymTable, const char *pcKey,
+                            size_t uHash) {
+   size_t uMask = ((size_t)1 << oSymTable->slotBits) - 1;
+   size_t uHome;
+   size_t uScanned;
+   unsigned char ucTag;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   uHome = SymTable_home(uHash, oSymTable->slotBits);
+   ucTag = SymTable_tag(uHash, oSymTable->slotBits);
+   for (uScanned = 0; uScanned <= oSymTable->maxDistance;
+        uScanned += uProbeWidth) {
+      size_t uGroup = (uHome + uScanned) & uMask;
+      uint32_t uEmpty;
+      uint32_t uMatch = (*pfProbe)(&oSymTable->tags[uGroup], ucTag,
+                                   &uEmpty);
+
+      /* ignores matches after the end of pcKey's run */
+      if (uEmpty != 0)
+         uMatch &= (uEmpty & (~uEmpty + 1)) - 1;
+
+      /* compares the hash codes and then the keys of the slots
+         whose tags matched */
+      for (; uMatch != 0; uMatch &= uMatch - 1) {
+         size_t uIndex = (uGroup + SymTable_lowestBit(uMatch)) & uMask;
+         struct Slot *psSlot = &oSymTable->slots[uIndex];
+
+         if (psSlot->uHash == uHash
+             && strcmp(psSlot->pcKey, pcKey) == 0)
+            return uIndex;
+      }
+
+      /* checks if the probe reached the end of pcKey's run */
+      if (uEmpty != 0)
+         break;
+   }
+   return uMask + 1;
+}
+
+/* Takes in a Table, oSymTable, and a Slot, sSlot, whose key is
+   known not to be within oSymTable. Stores sSlot within
+   oSymTable, moving richer slots forward as needed so that every
+   key stays as close to its home slot as possible. oSymTable
+   must contain at least one empty slot. */
+static void SymTable_place(SymTable_T oSymTable, struct Slot sSlot) {
+   size_t uMask = ((size_t)1 << oSymTable->slotBits) - 1;
+   size_t uIndex;
+   size_t uDistance;
+
+   assert(oSymTable != NULL);
+
+   uIndex = SymTable_home(sSlot.uHash, oSymTable->slotBits);
+   for (uDistance = 0; ; uDistance++) {
+      struct Slot *psSlot = &oSymTable->slots[uIndex];
+      size_t uResident;
+
+      /* stores sSlot in the first empty slot */
+      if (psSlot->pcKey == NULL) {
+         *psSlot = sSlot;
+         SymTable_setTag(oSymTable, uIndex,
+                         SymTable_tag(sSlot.uHash,
+                                      oSymTable->slotBits));
+         if (uDistance > oSymTable->maxDistance)
+            oSymTable->maxDistance = uDistance;
+         return;
+      }
+
+      /* takes the slot from a key that is closer to its home and
+         continues placing the displaced key instead */
+      uResident = SymTable_distance(oSymTable, uIndex);
+      if (uResident < uDistance) {
+         struct Slot sDisplaced = *psSlot;
+         *psSlot = sSlot;
+         SymTable_setTag(oSymTable, uIndex,
+                         SymTable_tag(sSlot.uHash,
+                                      oSymTable->slotBits));
+         if (uDistance > oSymTable->maxDistance)
+            oSymTable->maxDistance = uDistance;
+         sSlot = sDisplaced;
+         uDistance = uResident;
+      }
+
+      uIndex = (uIndex + 1) & uMask;
+   }
+}
+
+/* Takes in an SymTable_T as input, oSymTable, that will be
+   modified to have twice as many slots, with all of its
+   bindings being placed again from their stored hash codes.
+   Returns 1 (TRUE) if successful, or 0 (FALSE) leaving
+   oSymTable unchanged if insufficient memory is available. */
+static int SymTable_grow(SymTable_T oSymTable) {
+   struct Slot *psOldSlots;
+   unsigned char *pucOldTags;
+   size_t uOldCount;
+   size_t uNewCount;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   uOldCount = (size_t)1 << oSymTable->slotBits;
+   uNewCount = uOldCount << 1;
+
+   /* checks that the new slot count did not overflow */
+   if (uNewCount == 0 || uNewCount > (size_t)-1 / sizeof(struct Slot))
+      return 0;
+
+   psOldSlots = oSymTable->slots;
+   pucOldTags = oSymTable->tags;
+   oSymTable->slots = (struct Slot*)
+      calloc(uNewCount, sizeof(struct Slot));
+   oSymTable->tags = (unsigned char*)
+      calloc(uNewCount + MAX_GROUP_WIDTH - 1, 1);
+
+   /* checks to see if either calloc failed */
+   if (oSymTable->slots == NULL || oSymTable->tags == NULL) {
+      free(oSymTable->slots);
+      free(oSymTable->tags);
+      oSymTable->slots = psOldSlots;
+      oSymTable->tags = pucOldTags;
+      return 0;
+   }
+   oSymTable->slotBits++;
+   oSymTable->maxDistance = 0;
+
+   /* places every binding into the new slots */
+   for (i = 0; i < uOldCount; i++)
+      if (psOldSlots[i].pcKey != NULL)
+         SymTable_place(oSymTable, psOldSlots[i]);
+
+   free(psOldSlots);
+   free(pucOldTags);
+   return 1;
+}
+
+SymTable_T SymTable_new(void){
+   SymTable_T oSymTable;
+
+   /* intilizes the size of oSymTable to be the same size as
+      the Table struct */
+   oSymTable = (SymTable_T)malloc(sizeof(struct Table));
+
+   /* checks to see if malloc failed */
+   if (oSymTable == NULL)
+      return NULL;
+
+   /* sets the number of inputs to be 0 intially representing
+      an empty SymTable_T */
+   oSymTable->tableInputs = 0;
+   oSymTable->slotBits = INITIAL_SLOT_BITS;
+   oSymTable->maxDistance = 0;
+
+   /* chooses the probe the first time a Table is created */
+   if (pfProbe == NULL)
+      SymTable_selectProbe();
+
+   /* intilizes the slots and tags and marks all of them empty */
+   oSymTable->slots = (struct Slot*)
+      calloc(INITIAL_SLOT_COUNT, sizeof(struct Slot));
+   oSymTable->tags = (unsigned char*)
+      calloc(INITIAL_SLOT_COUNT + MAX_GROUP_WIDTH - 1, 1);
+
+   /* checks to see if either calloc failed */
+   if (oSymTable->slots == NULL || oSymTable->tags == NULL) {
+      free(oSymTable->slots);
+      free(oSymTable->tags);
+      free(oSymTable);
+      return NULL;
+   }
+
+   return oSymTable;
+}
+
+void SymTable_free(SymTable_T oSymTable){
+   size_t uCount;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* frees the defensive copy of every key */
+   uCount = (size_t)1 << oSymTable->slotBits;
+   for (i = 0; i < uCount; i++)
+      free((void *)oSymTable->slots[i].pcKey);
+
+   /* frees the memory created for the oSymTable structure,
+      the slots and the tags */
+   free(oSymTable->slots);
+   free(oSymTable->tags);
+   free(oSymTable);
+}
+
+size_t SymTable_getLength(SymTable_T oSymTable){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* returns the number of inputs wihtin oSymTable */
+   return oSymTable->tableInputs;
+}
+
+int SymTable_put(SymTable_T oSymTable, const char *pcKey,
+                 const void *pvValue) {
+   struct Slot sSlot;
+   char *pcKeySave;
+   size_t uCount;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   sSlot.uHash = SymTable_hash(pcKey);
+
+   /* checks if oSymTable already contains pcKey */
+   uCount = (size_t)1 << oSymTable->slotBits;
+   if (SymTable_find(oSymTable, pcKey, sSlot.uHash) != uCount)
+      return 0;
+
+   /* grows oSymTable once it is too full. If that fails the
+      binding can still be added as long as one slot stays empty */
+   if ((oSymTable->tableInputs + 1) * MAX_LOAD_DENOMINATOR
+       > uCount * MAX_LOAD_NUMERATOR
+       && !SymTable_grow(oSymTable)
+       && oSymTable->tableInputs + 1 >= uCount)
+      return 0;
+
+   /* allocates memory for which the defensive key will reside */
+   pcKeySave = malloc(strlen(pcKey) + 1);
+
+   /* checks to see if malloc failed */
+   if (pcKeySave == NULL)
+      /* returns 0 representing that their was
+         insufficeint memory */
+      return 0;
+
+   /* copies the key into allocated memory allowing a
+      defensive copy to be stored */
+   strcpy(pcKeySave, pcKey);
+
+   sSlot.pcKey = pcKeySave;
+   sSlot.pvValue = pvValue;
+   SymTable_place(oSymTable, sSlot);
+
+   /* increments the number of inputs stored in oSymTable */
+   oSymTable->tableInputs++;
+
+   return 1;
+}
+
+void *SymTable_replace(SymTable_T oSymTable, const char *pcKey,
+                       const void *pvValue){
+   size_t uIndex;
+   const void *pvValueSave;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   uIndex = SymTable_find(oSymTable, pcKey, SymTable_hash(pcKey));
+   if (uIndex == (size_t)1 << oSymTable->slotBits)
+      return NULL;
+
+   /* replaces the binding's value with pvValue */
+   pvValueSave = oSymTable->slots[uIndex].pvValue;
+   oSymTable->slots[uIndex].pvValue = pvValue;
+
+   /* returns the old pvValue */
+   return (void*)pvValueSave;
+}
+
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   return SymTable_find(oSymTable, pcKey, SymTable_hash(pcKey))
+      != (size_t)1 << oSymTable->slotBits;
+}
+
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey){
+   size_t uIndex;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   uIndex = SymTable_find(oSymTable, pcKey, SymTable_hash(pcKey));
+   if (uIndex == (size_t)1 << oSymTable->slotBits)
+      /* returns NULL representing that no such binding exists*/
+      return NULL;
+
+   return (void*)oSymTable->slots[uIndex].pvValue;
+}
+
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey){
+   size_t uMask;
+   size_t uIndex;
+   size_t uNext;
+   const void *bindingValue;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   uMask = ((size_t)1 << oSymTable->slotBits) - 1;
+   uIndex = SymTable_find(oSymTable, pcKey, SymTable_hash(pcKey));
+   if (uIndex == uMask + 1)
+      return NULL;
+
+   /* stores the removed bindings value and frees its key */
+   bindingValue = oSymTable->slots[uIndex].pvValue;
+   free((void *)oSymTable->slots[uIndex].pcKey);
+
+   /* shifts the following slots of the run back by one until
+      an empty slot or a slot already at its home is reached,
+      so no tombstone is left behind */
+   for (uNext = (uIndex + 1) & uMask;
+        oSymTable->slots[uNext].pcKey != NULL
+           && SymTable_distance(oSymTable, uNext) != 0;
+        uNext = (uNext + 1) & uMask) {
+      oSymTable->slots[uIndex] = oSymTable->slots[uNext];
+      SymTable_setTag(oSymTable, uIndex, oSymTable->tags[uNext]);
+      uIndex = uNext;
+   }
+   oSymTable->slots[uIndex].pcKey = NULL;
+   SymTable_setTag(oSymTable, uIndex, EMPTY_TAG);
+
+   /* decrements the number of inputs within oSymTable */
+   oSymTable->tableInputs--;
+
+   return (void*)bindingValue;
+}
+
+void SymTable_map(SymTable_T oSymTable,
+                  void (*pfApply) (const char *pcKey, void
+                                   *pvValue, void *pvExtra),
+                  const void *pvExtra){
+   size_t uCount;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input where unexpected.
+      pvExtra can be NULL */
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   /* iterates through every occupied slot of oSymTable */
+   uCount = (size_t)1 << oSymTable->slotBits;
+   for (i = 0; i < uCount; i++) {
+      if (oSymTable->slots[i].pcKey != NULL)
+         /* applies function *pfApply to each binding in
+            oSymtable passing pvExtra as an extra parameter*/
+         (*pfApply)(oSymTable->slots[i].pcKey,
+                    (void*)oSymTable->slots[i].pvValue,
+                    (void*)pvExtra);
+   }
+}
@@ -0,0 +1,860 @@
+/* implements the SymTable B+-tree version, which keeps its keys
+   in order */
+
+/* exposes posix_memalign under -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* includes libraries*/
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "symtable.h"
+
+/* the size of a cache line, to which every node is aligned */
+enum {CACHE_LINE_SIZE = 64};
+
+/* the number of cache lines that a node fills. One line only
+   holds seven pointers, so a node spans a few lines to give the
+   tree a fan-out that keeps it shallow */
+enum {NODE_LINES = 4};
+
+/* the most keys that a node holds. A leaf holds a key and a value
+   for each, and an internal node a key and a child for each and
+   one more child, which together with the count or the link to the
+   next leaf fill NODE_LINES cache lines */
+enum {NODE_KEYS =
+   NODE_LINES * CACHE_LINE_SIZE / (2 * sizeof(void*)) - 1};
+
+/* every node other than the root holds at least MIN_KEYS keys,
+   except that a leaf holds fewer if a separator could not be
+   allocated while removing one of its keys */
+enum {MIN_KEYS = NODE_KEYS / 2};
+
+/* the most levels of internal nodes. Every internal node other
+   than the root has at least MIN_KEYS + 1 children, so no tree that
+   fits in memory comes close */
+enum {MAX_HEIGHT = 32};
+
+/* Each Leaf stores up to NODE_KEYS bindings in the order of their
+   keys. The leaves are linked in that order, so that a scan walks
+   from one leaf to the next without going back up the tree */
+struct Leaf {
+   /* The number of bindings within the Leaf */
+   size_t count;
+
+   /* The address of the next Leaf, or NULL for the last one */
+   struct Leaf *psNextLeaf;
+
+   /* stores the defensive copies of the keys, in order */
+   char *apcKeys[NODE_KEYS];
+
+   /* stores the values of the bindings, in the order of the keys */
+   void *apvValues[NODE_KEYS];
+};
+
+/* Each Node is an internal node of the tree. Every key below
+   apvChildren[i] is less than apcKeys[i], and every key below
+   apvChildren[i + 1] is greater than or equal to it */
+struct Node {
+   /* The number of separator keys, which is one less than the
+      number of children */
+   size_t count;
+
+   /* stores the separator keys, each of which the Node owns */
+   char *apcKeys[NODE_KEYS];
+
+   /* stores the children, which are Leaves if the Node is on the
+      lowest internal level and Nodes otherwise */
+   void *apvChildren[NODE_KEYS + 1];
+};
+
+/* Table is a structure that contains the root of the tree.
+   It also stores the number of elements contained within the
+   Table and the number of internal levels above the leaves */
+struct Table {
+   /* The number of elements contained within
+      the Table */
+   size_t tableInputs;
+
+   /* the root, which is a Leaf if height is 0 and a Node
+      otherwise */
+   void *pvRoot;
+
+   /* the number of levels of Nodes above the Leaves */
+   int height;
+};
+
+/* Takes in a size in bytes, uSize. Returns uninitialized memory of
+   that size aligned to a cache line, or NULL if insufficient memory
+   is available. */
+static void *SymTable_allocNode(size_t uSize) {
+   void *pvNode;
+
+   if (posix_memalign(&pvNode, CACHE_LINE_SIZE, uSize) != 0)
+      return NULL;
+   return pvNode;
+}
+
+/* Takes in a key, pcKey. Returns a defensive copy of pcKey, or
+   NULL if insufficient memory is available. */
+static char *SymTable_copyKey(const char *pcKey) {
+   char *pcKeySave;
+
+   assert(pcKey != NULL);
+
+   pcKeySave = (char*)malloc(strlen(pcKey) + 1);
+   if (pcKeySave != NULL)
+      strcpy(pcKeySave, pcKey);
+   return pcKeySave;
+}
+
+/* Takes in a Node, psNode, and a key, pcKey, or NULL for a key
+   less than every other. Returns the index of the child of psNode
+   below which pcKey is, or would be, found. */
+static size_t SymTable_childIndex(const struct Node *psNode,
+                                  const char *pcKey) {
+   size_t uLow = 0;
+   size_t uHigh;
+   size_t uMid;
+
+   assert(psNode != NULL);
+
+   if (pcKey == NULL)
+      return 0;
+
+   /* finds the first separator greater than pcKey */
+   uHigh = psNode->count;
+   while (uLow < uHigh) {
+      uMid = uLow + (uHigh - uLow) / 2;
+      if (strcmp(pcKey, psNode->apcKeys[uMid]) < 0)
+         uHigh = uMid;
+      else
+         uLow = uMid + 1;
+   }
+   return uLow;
+}
+
+/* Takes in a Leaf, psLeaf, a key, pcKey, and the address of an int,
+   piFound. Returns the index of the first key of psLeaf that is
+   greater than or equal to pcKey, and sets *piFound to 1 (TRUE) if
+   that key is pcKey or 0 (FALSE) otherwise. */
+static size_t SymTable_leafIndex(const struct Leaf *psLeaf,
+                                 const char *pcKey, int *piFound) {
+   size_t uLow = 0;
+   size_t uHigh;
+   size_t uMid;
+   int iCompare;
+
+   assert(psLeaf != NULL);
+   assert(pcKey != NULL);
+   assert(piFound != NULL);
+
+   uHigh = psLeaf->count;
+   while (uLow < uHigh) {
+      uMid = uLow + (uHigh - uLow) / 2;
+      iCompare = strcmp(psLeaf->apcKeys[uMid], pcKey);
+      if (iCompare == 0) {
+         *piFound = 1;
+         return uMid;
+      }
+      if (iCompare < 0)
+         uLow = uMid + 1;
+      else
+         uHigh = uMid;
+   }
+   *piFound = 0;
+   return uLow;
+}
+
+/* Takes in a Table, oSymTable, a key, pcKey, or NULL for a key less
+   than every other, and two arrays, apsPath and auIndex, of
+   oSymTable->height elements that can be NULL. Returns the Leaf in
+   which pcKey is, or would be, found. Stores the Node of each
+   level on the way down, from the root, in apsPath and the index
+   of the child taken from it in auIndex. */
+static struct Leaf *SymTable_descend(SymTable_T oSymTable,
+                                     const char *pcKey,
+                                     struct Node *apsPath[],
+                                     size_t auIndex[]) {
+   void *pvNode;
+   size_t uIndex;
+   /* for loop variable */
+   int i;
+
+   assert(oSymTable != NULL);
+
+   pvNode = oSymTable->pvRoot;
+   for (i = 0; i < oSymTable->height; i++) {
+      uIndex = SymTable_childIndex((struct Node*)pvNode, pcKey);
+      if (apsPath != NULL) {
+         apsPath[i] = (struct Node*)pvNode;
+         auIndex[i] = uIndex;
+      }
+      pvNode = ((struct Node*)pvNode)->apvChildren[uIndex];
+   }
+   return (struct Leaf*)pvNode;
+}
+
+/* Takes in a Node, psNode, that is not full, an index, uIndex, a
+   separator key, pcKey, and a child, pvChild. Inserts pcKey as the
+   separator at uIndex and pvChild as the child after it. */
+static void SymTable_insertChild(struct Node *psNode, size_t uIndex,
+                                 char *pcKey, void *pvChild) {
+   assert(psNode != NULL);
+   assert(psNode->count < NODE_KEYS);
+   assert(uIndex <= psNode->count);
+
+   memmove(&psNode->apcKeys[uIndex + 1], &psNode->apcKeys[uIndex],
+           (psNode->count - uIndex) * sizeof(char*));
+   memmove(&psNode->apvChildren[uIndex + 2],
+           &psNode->apvChildren[uIndex + 1],
+           (psNode->count - uIndex) * sizeof(void*));
+   psNode->apcKeys[uIndex] = pcKey;
+   psNode->apvChildren[uIndex + 1] = pvChild;
+   psNode->count++;
+}
+
+/* Takes in a Node, psNode, and an index, uIndex. Removes the
+   separator at uIndex and the child after it from psNode, without
+   freeing either. */
+static void SymTable_removeChild(struct Node *psNode, size_t uIndex) {
+   assert(psNode != NULL);
+   assert(uIndex < psNode->count);
+
+   memmove(&psNode->apcKeys[uIndex], &psNode->apcKeys[uIndex + 1],
+           (psNode->count - uIndex - 1) * sizeof(char*));
+   memmove(&psNode->apvChildren[uIndex + 1],
+           &psNode->apvChildren[uIndex + 2],
+           (psNode->count - uIndex - 1) * sizeof(void*));
+   psNode->count--;
+}
+
+/* Takes in a Table, oSymTable, the path, apsPath and auIndex, to
+   a full Leaf, psLeaf, the index, uPos, at which a key, pcKeySave,
+   with value pvValue, belongs in psLeaf, and the Leaf, psRight,
+   Nodes, apsNew, separator key, pcSeparator, and root, psRoot,
+   that splitting needs, which the caller allocated beforehand so
+   that nothing can fail. Splits psLeaf in two, moving its upper
+   half into psRight, and inserts the separator of the halves into
+   the parent, splitting every full Node above as well. */
+static void SymTable_split(SymTable_T oSymTable,
+                           struct Node *apsPath[], size_t auIndex[],
+                           struct Leaf *psLeaf, size_t uPos,
+                           char *pcKeySave, const void *pvValue,
+                           struct Leaf *psRight, struct Node *apsNew[],
+                           char *pcSeparator, struct Node *psRoot) {
+   char *apcKeys[NODE_KEYS + 1];
+   void *apvItems[NODE_KEYS + 2];
+   void *pvChild;
+   struct Node *psNode;
+   size_t uLeft;
+   size_t uIndex;
+   int iLevel;
+   int iNew = 0;
+
+   assert(oSymTable != NULL);
+   assert(psLeaf != NULL);
+   assert(psRight != NULL);
+   assert(pcSeparator != NULL);
+
+   /* puts the keys of psLeaf and the new key in order, and gives the
+      lower half to psLeaf and the upper half to psRight */
+   memcpy(apcKeys, psLeaf->apcKeys, uPos * sizeof(char*));
+   memcpy(apvItems, psLeaf->apvValues, uPos * sizeof(void*));
+   apcKeys[uPos] = pcKeySave;
+   apvItems[uPos] = (void*)pvValue;
+   memcpy(&apcKeys[uPos + 1], &psLeaf->apcKeys[uPos],
+          (NODE_KEYS - uPos) * sizeof(char*));
+   memcpy(&apvItems[uPos + 1], &psLeaf->apvValues[uPos],
+          (NODE_KEYS - uPos) * sizeof(void*));
+
+   uLeft = (NODE_KEYS + 1) / 2;
+   memcpy(psLeaf->apcKeys, apcKeys, uLeft * sizeof(char*));
+   memcpy(psLeaf->apvValues, apvItems, uLeft * sizeof(void*));
+   psLeaf->count = uLeft;
+   memcpy(psRight->apcKeys, &apcKeys[uLeft],
+          (NODE_KEYS + 1 - uLeft) * sizeof(char*));
+   memcpy(psRight->apvValues, &apvItems[uLeft],
+          (NODE_KEYS + 1 - uLeft) * sizeof(void*));
+   psRight->count = NODE_KEYS + 1 - uLeft;
+   psRight->psNextLeaf = psLeaf->psNextLeaf;
+   psLeaf->psNextLeaf = psRight;
+
+   /* inserts the separator into each Node above, splitting the full
+      ones and passing their middle separator up */
+   pvChild = psRight;
+   for (iLevel = oSymTable->height - 1; iLevel >= 0; iLevel--) {
+      psNode = apsPath[iLevel];
+      uIndex = auIndex[iLevel];
+      if (psNode->count < NODE_KEYS) {
+         SymTable_insertChild(psNode, uIndex, pcSeparator, pvChild);
+         return;
+      }
+
+      /* puts the separators and children in order, with the new
+         ones inserted, and gives the lower half to psNode and the
+         upper half to the new Node, passing the middle up */
+      memcpy(apcKeys, psNode->apcKeys, uIndex * sizeof(char*));
+      apcKeys[uIndex] = pcSeparator;
+      memcpy(&apcKeys[uIndex + 1], &psNode->apcKeys[uIndex],
+             (NODE_KEYS - uIndex) * sizeof(char*));
+      memcpy(apvItems, psNode->apvChildren,
+             (uIndex + 1) * sizeof(void*));
+      apvItems[uIndex + 1] = pvChild;
+      memcpy(&apvItems[uIndex + 2], &psNode->apvChildren[uIndex + 1],
+             (NODE_KEYS - uIndex) * sizeof(void*));
+
+      uLeft = (NODE_KEYS + 1) / 2;
+      memcpy(psNode->apcKeys, apcKeys, uLeft * sizeof(char*));
+      memcpy(psNode->apvChildren, apvItems,
+             (uLeft + 1) * sizeof(void*));
+      psNode->count = uLeft;
+      memcpy(apsNew[iNew]->apcKeys, &apcKeys[uLeft + 1],
+             (NODE_KEYS - uLeft) * sizeof(char*));
+      memcpy(apsNew[iNew]->apvChildren, &apvItems[uLeft + 1],
+             (NODE_KEYS + 1 - uLeft) * sizeof(void*));
+      apsNew[iNew]->count = NODE_KEYS - uLeft;
+
+      pcSeparator = apcKeys[uLeft];
+      pvChild = apsNew[iNew];
+      iNew++;
+   }
+
+   /* grows the tree by one level once the root has split */
+   assert(psRoot != NULL);
+   psRoot->count = 1;
+   psRoot->apcKeys[0] = pcSeparator;
+   psRoot->apvChildren[0] = oSymTable->pvRoot;
+   psRoot->apvChildren[1] = pvChild;
+   oSymTable->pvRoot = psRoot;
+   oSymTable->height++;
+}
+
+/* Takes in a Table, oSymTable, and the path, apsPath and auIndex,
+   to a Leaf, psLeaf, that has just lost a key. If psLeaf holds
+   fewer than MIN_KEYS keys, borrows a key from a sibling or merges
+   psLeaf with one, and repairs every Node above that is left with
+   too few separators the same way. Frees the root once it has a
+   single child, which then becomes the root. */
+static void SymTable_rebalance(SymTable_T oSymTable,
+                               struct Node *apsPath[],
+                               size_t auIndex[],
+                               struct Leaf *psLeaf) {
+   struct Node *psParent;
+   struct Node *psNode;
+   struct Node *psSibling;
+   struct Leaf *psLeft;
+   struct Leaf *psRight;
+   char *pcSeparator;
+   size_t uIndex;
+   int iLevel;
+
+   assert(oSymTable != NULL);
+   assert(psLeaf != NULL);
+
+   if (oSymTable->height == 0 || psLeaf->count >= MIN_KEYS)
+      return;
+
+   iLevel = oSymTable->height - 1;
+   psParent = apsPath[iLevel];
+   uIndex = auIndex[iLevel];
+   psLeft = (uIndex > 0) ?
+      (struct Leaf*)psParent->apvChildren[uIndex - 1] : NULL;
+   psRight = (uIndex < psParent->count) ?
+      (struct Leaf*)psParent->apvChildren[uIndex + 1] : NULL;
+
+   /* borrows the last key of the left sibling, which becomes the
+      new separator */
+   if (psLeft != NULL && psLeft->count > MIN_KEYS
+       && (pcSeparator = SymTable_copyKey(
+              psLeft->apcKeys[psLeft->count - 1])) != NULL) {
+      memmove(&psLeaf->apcKeys[1], psLeaf->apcKeys,
+              psLeaf->count * sizeof(char*));
+      memmove(&psLeaf->apvValues[1], psLeaf->apvValues,
+              psLeaf->count * sizeof(void*));
+      psLeft->count--;
+      psLeaf->apcKeys[0] = psLeft->apcKeys[psLeft->count];
+      psLeaf->apvValues[0] = psLeft->apvValues[psLeft->count];
+      psLeaf->count++;
+      free(psParent->apcKeys[uIndex - 1]);
+      psParent->apcKeys[uIndex - 1] = pcSeparator;
+      return;
+   }
+
+   /* borrows the first key of the right sibling, whose next key
+      becomes the new separator */
+   if (psRight != NULL && psRight->count > MIN_KEYS
+       && (pcSeparator = SymTable_copyKey(psRight->apcKeys[1]))
+          != NULL) {
+      psLeaf->apcKeys[psLeaf->count] = psRight->apcKeys[0];
+      psLeaf->apvValues[psLeaf->count] = psRight->apvValues[0];
+      psLeaf->count++;
+      psRight->count--;
+      memmove(psRight->apcKeys, &psRight->apcKeys[1],
+              psRight->count * sizeof(char*));
+      memmove(psRight->apvValues, &psRight->apvValues[1],
+              psRight->count * sizeof(void*));
+      free(psParent->apcKeys[uIndex]);
+      psParent->apcKeys[uIndex] = pcSeparator;
+      return;
+   }
+
+   /* merges psLeaf with a sibling into the left one of the two,
+      unless the separator of a borrow could not be allocated and
+      the keys do not fit, in which case psLeaf stays short */
+   if (psLeft != NULL && psLeft->count + psLeaf->count <= NODE_KEYS)
+      psRight = psLeaf;
+   else if (psRight != NULL
+            && psLeaf->count + psRight->count <= NODE_KEYS) {
+      psLeft = psLeaf;
+      uIndex++;
+   }
+   else
+      return;
+   memcpy(&psLeft->apcKeys[psLeft->count], psRight->apcKeys,
+          psRight->count * sizeof(char*));
+   memcpy(&psLeft->apvValues[psLeft->count], psRight->apvValues,
+          psRight->count * sizeof(void*));
+   psLeft->count += psRight->count;
+   psLeft->psNextLeaf = psRight->psNextLeaf;
+   free(psRight);
+   free(psParent->apcKeys[uIndex - 1]);
+   SymTable_removeChild(psParent, uIndex - 1);
+
+   /* repairs the Nodes above, which lost a child, by rotating a
+      separator through their parent or merging them with a
+      sibling and the separator between them */
+   for (; iLevel > 0 && psParent->count < MIN_KEYS; iLevel--) {
+      psNode = psParent;
+      psParent = apsPath[iLevel - 1];
+      uIndex = auIndex[iLevel - 1];
+
+      if (uIndex > 0) {
+         psSibling = (struct Node*)psParent->apvChildren[uIndex - 1];
+         if (psSibling->count > MIN_KEYS) {
+            memmove(&psNode->apcKeys[1], psNode->apcKeys,
+                    psNode->count * sizeof(char*));
+            memmove(&psNode->apvChildren[1], psNode->apvChildren,
+                    (psNode->count + 1) * sizeof(void*));
+            psNode->apcKeys[0] = psParent->apcKeys[uIndex - 1];
+            psNode->apvChildren[0] =
+               psSibling->apvChildren[psSibling->count];
+            psNode->count++;
+            psSibling->count--;
+            psParent->apcKeys[uIndex - 1] =
+               psSibling->apcKeys[psSibling->count];
+            return;
+         }
+      }
+      if (uIndex < psParent->count) {
+         psSibling = (struct Node*)psParent->apvChildren[uIndex + 1];
+         if (psSibling->count > MIN_KEYS) {
+            psNode->apcKeys[psNode->count] = psParent->apcKeys[uIndex];
+            psNode->apvChildren[psNode->count + 1] =
+               psSibling->apvChildren[0];
+            psNode->count++;
+            psParent->apcKeys[uIndex] = psSibling->apcKeys[0];
+            psSibling->count--;
+            memmove(psSibling->apcKeys, &psSibling->apcKeys[1],
+                    psSibling->count * sizeof(char*));
+            memmove(psSibling->apvChildren, &psSibling->apvChildren[1],
+                    (psSibling->count + 1) * sizeof(void*));
+            return;
+         }
+      }
+
+      /* merges into the left one of psNode and its sibling */
+      if (uIndex > 0) {
+         psSibling = psNode;
+         psNode = (struct Node*)psParent->apvChildren[uIndex - 1];
+      }
+      else {
+         psSibling = (struct Node*)psParent->apvChildren[uIndex + 1];
+         uIndex++;
+      }
+      psNode->apcKeys[psNode->count] = psParent->apcKeys[uIndex - 1];
+      memcpy(&psNode->apcKeys[psNode->count + 1], psSibling->apcKeys,
+             psSibling->count * sizeof(char*));
+      memcpy(&psNode->apvChildren[psNode->count + 1],
+             psSibling->apvChildren,
+             (psSibling->count + 1) * sizeof(void*));
+      psNode->count += psSibling->count + 1;
+      free(psSibling);
+      SymTable_removeChild(psParent, uIndex - 1);
+   }
+
+   /* shrinks the tree by one level once the root has one child */
+   if (iLevel == 0 && psParent->count == 0) {
+      oSymTable->pvRoot = psParent->apvChildren[0];
+      oSymTable->height--;
+      free(psParent);
+   }
+}
+
+/* Takes in a node, pvNode, and the number of levels of Nodes,
+   iHeight, from pvNode down to the Leaves. Frees pvNode and every
+   node below it, with their keys. */
+static void SymTable_freeNode(void *pvNode, int iHeight) {
+   struct Node *psNode;
+   struct Leaf *psLeaf;
+   /* for loop variable */
+   size_t i;
+
+   assert(pvNode != NULL);
+
+   if (iHeight == 0) {
+      psLeaf = (struct Leaf*)pvNode;
+      for (i = 0; i < psLeaf->count; i++)
+         free(psLeaf->apcKeys[i]);
+   }
+   else {
+      psNode = (struct Node*)pvNode;
+      for (i = 0; i < psNode->count; i++)
+         free(psNode->apcKeys[i]);
+      for (i = 0; i <= psNode->count; i++)
+         SymTable_freeNode(psNode->apvChildren[i], iHeight - 1);
+   }
+   free(pvNode);
+}
+
+/* Takes in a Table, oSymTable, a key, pcLow, or NULL, a function,
+   *pfStop, and its argument, pvStop. Applies *pfApply to each
+   binding in key order, starting with the first whose key is
+   greater than or equal to pcLow, or with the first binding if
+   pcLow is NULL, and stopping before the first binding for which
+   (*pfStop)(pcKey, pvStop) returns 1 (TRUE). */
+static void SymTable_mapFrom(SymTable_T oSymTable, const char *pcLow,
+                             int (*pfStop) (const char *pcKey,
+                                            const void *pvStop),
+                             const void *pvStop,
+                             void (*pfApply) (const char *pcKey,
+                                              void *pvValue,
+                                              void *pvExtra),
+                             const void *pvExtra) {
+   struct Leaf *psLeaf;
+   size_t uPos = 0;
+   int iFound;
+
+   assert(oSymTable != NULL);
+   assert(pfStop != NULL);
+   assert(pfApply != NULL);
+
+   psLeaf = SymTable_descend(oSymTable, pcLow, NULL, NULL);
+   if (pcLow != NULL)
+      uPos = SymTable_leafIndex(psLeaf, pcLow, &iFound);
+
+   /* walks the linked leaves until the stopping key or the end */
+   while (psLeaf != NULL) {
+      for (; uPos < psLeaf->count; uPos++) {
+         if ((*pfStop)(psLeaf->apcKeys[uPos], pvStop))
+            return;
+         (*pfApply)(psLeaf->apcKeys[uPos], psLeaf->apvValues[uPos],
+                    (void*)pvExtra);
+      }
+      psLeaf = psLeaf->psNextLeaf;
+      uPos = 0;
+   }
+}
+
+/* Takes in a key, pcKey, and a key, pvHigh, or NULL. Returns 1
+   (TRUE) if pcKey is greater than or equal to pvHigh, or 0 (FALSE)
+   if it is less or pvHigh is NULL. */
+static int SymTable_atOrAbove(const char *pcKey, const void *pvHigh) {
+   assert(pcKey != NULL);
+
+   return pvHigh != NULL && strcmp(pcKey, (const char*)pvHigh) >= 0;
+}
+
+/* Takes in a key, pcKey, and a prefix, pvPrefix. Returns 1 (TRUE)
+   if pcKey does not start with pvPrefix, or 0 (FALSE) if it
+   does. */
+static int SymTable_pastPrefix(const char *pcKey,
+                               const void *pvPrefix) {
+   assert(pcKey != NULL);
+   assert(pvPrefix != NULL);
+
+   return strncmp(pcKey, (const char*)pvPrefix,
+                  strlen((const char*)pvPrefix)) != 0;
+}
+
+/* Takes in a key, pcKey, and any value, pvUnused. Returns 0
+   (FALSE). */
+static int SymTable_never(const char *pcKey, const void *pvUnused) {
+   assert(pcKey != NULL);
+   (void)pvUnused;
+
+   return 0;
+}
+
+SymTable_T SymTable_new(void){
+   SymTable_T oSymTable;
+   struct Leaf *psLeaf;
+
+   /* intilizes the size of oSymTable to be the same size as
+      the Table struct */
+   oSymTable = (SymTable_T)malloc(sizeof(struct Table));
+
+   /* checks to see if malloc failed */
+   if (oSymTable == NULL)
+      return NULL;
+
+   /* starts with a single empty Leaf as the root */
+   psLeaf = (struct Leaf*)SymTable_allocNode(sizeof(struct Leaf));
+   if (psLeaf == NULL) {
+      free(oSymTable);
+      return NULL;
+   }
+   psLeaf->count = 0;
+   psLeaf->psNextLeaf = NULL;
+
+   /* sets the number of inputs to be 0 intially representing
+      an empty SymTable_T */
+   oSymTable->tableInputs = 0;
+   oSymTable->pvRoot = psLeaf;
+   oSymTable->height = 0;
+
+   return oSymTable;
+}
+
+void SymTable_free(SymTable_T oSymTable){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* frees every node and key, and then the Table */
+   SymTable_freeNode(oSymTable->pvRoot, oSymTable->height);
+   free(oSymTable);
+}
+
+size_t SymTable_getLength(SymTable_T oSymTable){
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+
+   /* returns the number of inputs wihtin oSymTable */
+   return oSymTable->tableInputs;
+}
+
+int SymTable_put(SymTable_T oSymTable, const char *pcKey,
+                 const void *pvValue) {
+   struct Node *apsPath[MAX_HEIGHT];
+   size_t auIndex[MAX_HEIGHT];
+   struct Node *apsNew[MAX_HEIGHT];
+   struct Node *psRoot = NULL;
+   struct Leaf *psLeaf;
+   struct Leaf *psRight = NULL;
+   char *pcKeySave;
+   char *pcSeparator = NULL;
+   const char *pcRightFirst;
+   size_t uPos;
+   int iFound;
+   int iSplits = 0;
+   int iFailed = 0;
+   /* for loop variable */
+   int i;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   /* checks if oSymTable already contains pcKey */
+   psLeaf = SymTable_descend(oSymTable, pcKey, apsPath, auIndex);
+   uPos = SymTable_leafIndex(psLeaf, pcKey, &iFound);
+   if (iFound)
+      return 0;
+
+   /* counts the full Nodes above a full Leaf, which split along
+      with it */
+   if (psLeaf->count == NODE_KEYS)
+      for (i = oSymTable->height - 1;
+           i >= 0 && apsPath[i]->count == NODE_KEYS; i--)
+         iSplits++;
+
+   /* allocates everything that the insertion needs up front, so
+      that oSymTable is left unchanged if any of it fails */
+   pcKeySave = SymTable_copyKey(pcKey);
+   if (pcKeySave == NULL)
+      return 0;
+   if (psLeaf->count == NODE_KEYS) {
+      /* the first key of the upper half of the split Leaf becomes
+         the separator of the two halves */
+      i = (NODE_KEYS + 1) / 2;
+      if ((size_t)i == uPos)
+         pcRightFirst = pcKey;
+      else
+         pcRightFirst = psLeaf->apcKeys[(size_t)i < uPos ? i : i - 1];
+      psRight = (struct Leaf*)SymTable_allocNode(sizeof(struct Leaf));
+      pcSeparator = SymTable_copyKey(pcRightFirst);
+      iFailed = (psRight == NULL || pcSeparator == NULL);
+      for (i = 0; i < iSplits; i++) {
+         apsNew[i] = (struct Node*)
+            SymTable_allocNode(sizeof(struct Node));
+         iFailed |= (apsNew[i] == NULL);
+      }
+      if (iSplits == oSymTable->height) {
+         psRoot = (struct Node*)SymTable_allocNode(sizeof(struct Node));
+         iFailed |= (psRoot == NULL || iSplits == MAX_HEIGHT);
+      }
+      if (iFailed) {
+         for (i = 0; i < iSplits; i++)
+            free(apsNew[i]);
+         free(psRoot);
+         free(pcSeparator);
+         free(psRight);
+         free(pcKeySave);
+         return 0;
+      }
+      SymTable_split(oSymTable, apsPath, auIndex, psLeaf, uPos,
+                     pcKeySave, pvValue, psRight, apsNew,
+                     pcSeparator, psRoot);
+   }
+   else {
+      /* makes room for the new binding at its place in order */
+      memmove(&psLeaf->apcKeys[uPos + 1], &psLeaf->apcKeys[uPos],
+              (psLeaf->count - uPos) * sizeof(char*));
+      memmove(&psLeaf->apvValues[uPos + 1], &psLeaf->apvValues[uPos],
+              (psLeaf->count - uPos) * sizeof(void*));
+      psLeaf->apcKeys[uPos] = pcKeySave;
+      psLeaf->apvValues[uPos] = (void*)pvValue;
+      psLeaf->count++;
+   }
+
+   /* increments the number of inputs stored in oSymTable */
+   oSymTable->tableInputs++;
+
+   return 1;
+}
+
+void *SymTable_replace(SymTable_T oSymTable, const char *pcKey,
+                       const void *pvValue){
+   struct Leaf *psLeaf;
+   size_t uPos;
+   int iFound;
+   void *pvValueSave;
+
+   /* ensures no null input where unexpected.
+      pvValue can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psLeaf = SymTable_descend(oSymTable, pcKey, NULL, NULL);
+   uPos = SymTable_leafIndex(psLeaf, pcKey, &iFound);
+   if (!iFound)
+      return NULL;
+
+   /* replaces the binding's value with pvValue */
+   pvValueSave = psLeaf->apvValues[uPos];
+   psLeaf->apvValues[uPos] = (void*)pvValue;
+
+   /* returns the old pvValue */
+   return pvValueSave;
+}
+
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey){
+   int iFound;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   SymTable_leafIndex(SymTable_descend(oSymTable, pcKey, NULL, NULL),
+                      pcKey, &iFound);
+   return iFound;
+}
+
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey){
+   struct Leaf *psLeaf;
+   size_t uPos;
+   int iFound;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psLeaf = SymTable_descend(oSymTable, pcKey, NULL, NULL);
+   uPos = SymTable_leafIndex(psLeaf, pcKey, &iFound);
+   if (!iFound)
+      /* returns NULL representing that no such binding exists*/
+      return NULL;
+
+   return psLeaf->apvValues[uPos];
+}
+
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey){
+   struct Node *apsPath[MAX_HEIGHT];
+   size_t auIndex[MAX_HEIGHT];
+   struct Leaf *psLeaf;
+   size_t uPos;
+   int iFound;
+   void *bindingValue;
+
+   /* ensures no null input */
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psLeaf = SymTable_descend(oSymTable, pcKey, apsPath, auIndex);
+   uPos = SymTable_leafIndex(psLeaf, pcKey, &iFound);
+   if (!iFound)
+      return NULL;
+
+   /* stores the removed bindings value, frees its key and closes
+      the gap it leaves */
+   bindingValue = psLeaf->apvValues[uPos];
+   free(psLeaf->apcKeys[uPos]);
+   psLeaf->count--;
+   memmove(&psLeaf->apcKeys[uPos], &psLeaf->apcKeys[uPos + 1],
+           (psLeaf->count - uPos) * sizeof(char*));
+   memmove(&psLeaf->apvValues[uPos], &psLeaf->apvValues[uPos + 1],
+           (psLeaf->count - uPos) * sizeof(void*));
+   SymTable_rebalance(oSymTable, apsPath, auIndex, psLeaf);
+
+   /* decrements the number of inputs within oSymTable */
+   oSymTable->tableInputs--;
+
+   return bindingValue;
+}
+
+void SymTable_map(SymTable_T oSymTable,
+                  void (*pfApply) (const char *pcKey, void
+                                   *pvValue, void *pvExtra),
+                  const void *pvExtra){
+   /* ensures no null input where unexpected.
+      pvExtra can be NULL */
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   /* visits every binding in key order */
+   SymTable_mapFrom(oSymTable, NULL, SymTable_never, NULL, pfApply,
+                    pvExtra);
+}
+
+void SymTable_mapRange(SymTable_T oSymTable, const char *pcLow,
+                       const char *pcHigh,
+                       void (*pfApply) (const char *pcKey,
+                                        void *pvValue,
+                                        void *pvExtra),
+                       const void *pvExtra){
+   /* ensures no null input where unexpected.
+      pcLow, pcHigh and pvExtra can be NULL */
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   SymTable_mapFrom(oSymTable, pcLow, SymTable_atOrAbove, pcHigh,
+                    pfApply, pvExtra);
+}
+
+void SymTable_mapPrefix(SymTable_T oSymTable, const char *pcPrefix,
+                        void (*pfApply) (const char *pcKey,
+                                         void *pvValue,
+                                         void *pvExtra),
+                        const void *pvExtra){
+   /* ensures no null input where unexpected.
+      pvExtra can be NULL */
+   assert(oSymTable != NULL);
+   assert(pcPrefix != NULL);
+   assert(pfApply != NULL);
+
+   /* every key that starts with pcPrefix follows pcPrefix itself
+      and precedes every key after pcPrefix that does not */
+   SymTable_mapFrom(oSymTable, pcPrefix, SymTable_pastPrefix,
+                    pcPrefix, pfApply, pvExtra);
+}
@@ -0,0 +1,83 @@
+/* implements the workers that a SymTable uses to spread one large
+   operation across several threads */
+
+/* exposes the POSIX threads and sysconf under -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* includes libraries*/
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "symthreads.h"
+
+/* Each Worker holds what the thread of one worker needs */
+struct Worker {
+   /* the function that the worker calls and its argument */
+   void (*pfWork)(void *pvArg, size_t uWorker);
+   void *pvArg;
+
+   /* the number of the worker */
+   size_t uWorker;
+
+   /* the thread that runs the worker */
+   pthread_t thread;
+};
+
+/* Takes in a Worker, pvWorker, and calls its function with its
+   argument and number. Returns NULL. */
+static void *SymThreads_start(void *pvWorker) {
+   struct Worker *psWorker = (struct Worker*)pvWorker;
+
+   assert(psWorker != NULL);
+
+   (*psWorker->pfWork)(psWorker->pvArg, psWorker->uWorker);
+   return NULL;
+}
+
+size_t SymThreads_run(size_t uWorkers,
+                      void (*pfWork)(void *pvArg, size_t uWorker),
+                      void *pvArg) {
+   struct Worker *psWorkers;
+   size_t uStarted;
+   /* for loop variable */
+   size_t i;
+
+   /* ensures no null input where unexpected.
+      pvArg can be NULL */
+   assert(uWorkers > 0);
+   assert(pfWork != NULL);
+
+   /* runs every worker other than 0 on a thread of its own, unless
+      memory or threads run out */
+   psWorkers = NULL;
+   if (uWorkers > 1 && uWorkers <= (size_t)-1 / sizeof(struct Worker))
+      psWorkers = (struct Worker*)
+         malloc(uWorkers * sizeof(struct Worker));
+   for (uStarted = 1; psWorkers != NULL && uStarted < uWorkers;
+        uStarted++) {
+      psWorkers[uStarted].pfWork = pfWork;
+      psWorkers[uStarted].pvArg = pvArg;
+      psWorkers[uStarted].uWorker = uStarted;
+      if (pthread_create(&psWorkers[uStarted].thread, NULL,
+                         SymThreads_start,
+                         &psWorkers[uStarted]) != 0)
+         break;
+   }
+
+   /* runs worker 0 on the calling thread while the others run */
+   (*pfWork)(pvArg, 0);
+
+   for (i = 1; i < uStarted; i++)
+      pthread_join(psWorkers[i].thread, NULL);
+   free(psWorkers);
+   return uStarted;
+}
+
+size_t SymThreads_processorCount(void) {
+   long lCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+   if (lCount < 1)
+      return 1;
+   return (size_t)lCount;
+}
@@ -0,0 +1,28 @@
+/* Contains the declarations for the workers that a SymTable uses to
+   spread one large operation, such as a map over every binding,
+   across several threads. The calling thread is always the first
+   worker, so an operation still completes, with fewer workers, if
+   no other thread can be created. */
+
+/* insures that the declarations are only included once */
+#ifndef SYMTHREADS_INCLUDED
+#define SYMTHREADS_INCLUDED
+#include <stddef.h>
+
+/* Takes in a number of workers, uWorkers, which is at least 1, a
+   function, pfWork, and an argument, pvArg. Calls
+   (*pfWork)(pvArg, uWorker) once for each worker, on threads that
+   run at the same time, and returns once every call has returned.
+   The workers are numbered from 0, and worker 0 runs on the calling
+   thread. If a thread cannot be created, the workers from that one
+   on do not run. Returns the number of workers that ran, which is
+   at least 1. */
+size_t SymThreads_run(size_t uWorkers,
+                      void (*pfWork)(void *pvArg, size_t uWorker),
+                      void *pvArg);
+
+/* Returns the number of processors that are online, or 1 if it
+   cannot be determined. */
+size_t SymThreads_processorCount(void);
+
+#endif
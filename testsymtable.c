@@ -3,6 +3,11 @@
 /* Author: Bob Dondero                                                */
 /*--------------------------------------------------------------------*/
 
+#ifdef TEST_CONCURRENT
+/* Exposes pthreads under -std=c99. */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "symtable.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -14,10 +19,19 @@
 #include <sys/resource.h>
 #endif
 
+#ifdef TEST_CONCURRENT
+#include <pthread.h>
+#endif
+
 /*--------------------------------------------------------------------*/
 
 #define ASSURE(i) assure(i, __LINE__)
 
+/* The Makefile compiles this file once for each implementation that
+   provides functions beyond the basic ones, defining TEST_HASH,
+   TEST_LIST, TEST_TREE, TEST_ADAPTIVE or TEST_CONCURRENT, so that
+   the tests of those functions are only built where they exist. */
+
 /*--------------------------------------------------------------------*/
 
 /* If !iSuccessful, print a message to stdout indicating that the
@@ -697,8 +711,8 @@ static void testTableOfTables(void)
 /*--------------------------------------------------------------------*/
 
 /* Test the ability of a SymTable object to handle collisions.  This
-   test assumes that a SymTable object is implemented as a hash table,
-   that there are 509 buckets in the hash table, and that the
+   test assumes that a SymTable object is implemented as a hash table
+   that starts with 7 buckets and grows to 509, and that the
    implementation uses the hash function provided in the assignment
    specification. */
 
@@ -723,52 +737,53 @@ static void testCollisions(void)
    oSymTable = SymTable_new();
    ASSURE(oSymTable != NULL);
 
-   /* Note that strings "250", "469", "947", "1303", and "2016" hash
-      to the same bucket -- bucket 123. */
+   /* Note that strings "250", "3493", "3971", "8273", and "8751"
+      hash to the same bucket -- bucket 4 of 7, and bucket 123 of
+      509. */
 
    iSuccessful = SymTable_put(oSymTable, "250", acCenterField);
    ASSURE(iSuccessful);
 
-   iSuccessful = SymTable_put(oSymTable, "469", acCatcher);
+   iSuccessful = SymTable_put(oSymTable, "3493", acCatcher);
    ASSURE(iSuccessful);
 
-   iSuccessful = SymTable_put(oSymTable, "947", acFirstBase);
+   iSuccessful = SymTable_put(oSymTable, "3971", acFirstBase);
    ASSURE(iSuccessful);
 
-   iSuccessful = SymTable_put(oSymTable, "1303", acRightField);
+   iSuccessful = SymTable_put(oSymTable, "8273", acRightField);
    ASSURE(iSuccessful);
 
-   iSuccessful = SymTable_put(oSymTable, "2016", acRightField);
+   iSuccessful = SymTable_put(oSymTable, "8751", acRightField);
    ASSURE(iSuccessful);
 
    pcValue = SymTable_get(oSymTable, "250");
    ASSURE(pcValue == acCenterField);
 
-   pcValue = SymTable_get(oSymTable, "469");
+   pcValue = SymTable_get(oSymTable, "3493");
    ASSURE(pcValue == acCatcher);
 
-   pcValue = SymTable_get(oSymTable, "947");
+   pcValue = SymTable_get(oSymTable, "3971");
    ASSURE(pcValue == acFirstBase);
 
-   pcValue = SymTable_get(oSymTable, "1303");
+   pcValue = SymTable_get(oSymTable, "8273");
    ASSURE(pcValue == acRightField);
 
-   pcValue = SymTable_get(oSymTable, "2016");
+   pcValue = SymTable_get(oSymTable, "8751");
    ASSURE(pcValue == acRightField);
 
-   pcValue = SymTable_remove(oSymTable, "947");
+   pcValue = SymTable_remove(oSymTable, "3971");
    ASSURE(pcValue == acFirstBase);
 
-   pcValue = SymTable_remove(oSymTable, "2016");
+   pcValue = SymTable_remove(oSymTable, "8751");
    ASSURE(pcValue == acRightField);
 
    pcValue = SymTable_remove(oSymTable, "250");
    ASSURE(pcValue == acCenterField);
 
-   pcValue = SymTable_get(oSymTable, "469");
+   pcValue = SymTable_get(oSymTable, "3493");
    ASSURE(pcValue == acCatcher);
 
-   pcValue = SymTable_get(oSymTable, "1303");
+   pcValue = SymTable_get(oSymTable, "8273");
    ASSURE(pcValue == acRightField);
 
    SymTable_free(oSymTable);
@@ -777,9 +792,13 @@ static void testCollisions(void)
 /*--------------------------------------------------------------------*/
 
 /* Test the ability of a SymTable object to be large, that is, to
-   contain iBindingCount bindings. Write the time consumed to stdout. */
+   contain iBindingCount bindings. If pfSetUp is not NULL, call
+   (*pfSetUp)(oSymTable) on the large SymTable object before putting
+   any binding into it, and describe the test with pcMode. Write the
+   time consumed to stdout. */
 
-static void testLargeTable(int iBindingCount)
+static void testLargeTable(int iBindingCount,
+   void (*pfSetUp)(SymTable_T oSymTable), const char *pcMode)
 {
    enum {MAX_KEY_LENGTH = 10};
 
@@ -797,7 +816,8 @@ static void testLargeTable(int iBindingCount)
    size_t uLength2;
 
    printf("------------------------------------------------------\n");
-   printf("Testing a potentially large SymTable object.\n");
+   printf("Testing a potentially large SymTable object%s.\n",
+      pcMode);
    printf("No output except CPU time consumed should appear here:\n");
    fflush(stdout); 
 
@@ -815,6 +835,8 @@ static void testLargeTable(int iBindingCount)
    /* Create oSymTable, the primary SymTable object. */
    oSymTable = SymTable_new();
    ASSURE(oSymTable != NULL);
+   if (pfSetUp != NULL)
+      (*pfSetUp)(oSymTable);
 
    /* Put iBindingCount new bindings into oSymTable.  Each binding's
       key and value contain the same characters. */
@@ -920,50 +942,2403 @@ static void testLargeTable(int iBindingCount)
 
 /*--------------------------------------------------------------------*/
 
-/* Test the SymTable ADT.  Write the output of the tests to stdout.
-   As always, argc is the command-line argument count, argv contains
-   the command-line arguments, and argv[0] is the name of the
-   executable binary file. argv[1] is the number of bindings to put
-   into a potentially large SymTable object.  Exit with EXIT_FAILURE
-   if argv[1] is missing or not numeric.  Otherwise return 0. */
+#if defined(TEST_LIST) || defined(TEST_HASH)
+/* Test the SymTable_upsert() and SymTable_getOrPut() functions. */
 
-int main(int argc, char *argv[])
+static void testUpsert(void)
 {
-   int iBindingCount;
+   enum {MAX_KEY_LENGTH = 10};
+   enum {BINDING_COUNT = 2000};
 
-   if (argc != 2)
+   SymTable_T oSymTable;
+   char acJeter[] = "Jeter";
+   char acMantle[] = "Mantle";
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char acFirstBase[] = "First Base";
+   char acKey[MAX_KEY_LENGTH];
+   void **ppvValue;
+   void **ppvValue2;
+   char *pcValue;
+   int iInserted;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_upsert() and SymTable_getOrPut()\n");
+   printf("functions.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   /* Test SymTable_upsert() with a new key and an existing key. */
+
+   ppvValue = SymTable_upsert(oSymTable, acJeter, acShortstop,
+      &iInserted);
+   ASSURE(ppvValue != NULL);
+   ASSURE(iInserted);
+   ASSURE((ppvValue != NULL) && (*ppvValue == acShortstop));
+   ASSURE(SymTable_getLength(oSymTable) == 1);
+
+   ppvValue2 = SymTable_upsert(oSymTable, acJeter, acCenterField,
+      &iInserted);
+   ASSURE(ppvValue2 == ppvValue);
+   ASSURE(! iInserted);
+   ASSURE(SymTable_getLength(oSymTable) == 1);
+   pcValue = (char*)SymTable_get(oSymTable, acJeter);
+   ASSURE(pcValue == acCenterField);
+
+   /* Test SymTable_getOrPut() with an existing key and a new key. */
+
+   ppvValue2 = SymTable_getOrPut(oSymTable, acJeter, acFirstBase,
+      &iInserted);
+   ASSURE(ppvValue2 == ppvValue);
+   ASSURE(! iInserted);
+   pcValue = (char*)SymTable_get(oSymTable, acJeter);
+   ASSURE(pcValue == acCenterField);
+
+   ppvValue2 = SymTable_getOrPut(oSymTable, acMantle, acFirstBase,
+      &iInserted);
+   ASSURE(ppvValue2 != NULL);
+   ASSURE(iInserted);
+   ASSURE(SymTable_getLength(oSymTable) == 2);
+   pcValue = (char*)SymTable_get(oSymTable, acMantle);
+   ASSURE(pcValue == acFirstBase);
+
+   /* Test a NULL piInserted. */
+
+   ppvValue2 = SymTable_upsert(oSymTable, acMantle, acShortstop, NULL);
+   ASSURE(ppvValue2 != NULL);
+   pcValue = (char*)SymTable_get(oSymTable, acMantle);
+   ASSURE(pcValue == acShortstop);
+
+   ppvValue2 = SymTable_getOrPut(oSymTable, "Ruth", NULL, NULL);
+   ASSURE((ppvValue2 != NULL) && (*ppvValue2 == NULL));
+   ASSURE(SymTable_getLength(oSymTable) == 3);
+
+   /* Write through the returned address. */
+
+   *ppvValue = acFirstBase;
+   pcValue = (char*)SymTable_get(oSymTable, acJeter);
+   ASSURE(pcValue == acFirstBase);
+
+   /* Make sure that the returned address stays valid while many
+      bindings are added. */
+
+   for (i = 0; i < BINDING_COUNT; i++)
    {
-      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
-      exit(EXIT_FAILURE);
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acKey);
+      ASSURE(iSuccessful);
    }
+   ASSURE(*ppvValue == acFirstBase);
+   *ppvValue = acShortstop;
+   pcValue = (char*)SymTable_get(oSymTable, acJeter);
+   ASSURE(pcValue == acShortstop);
+   ppvValue2 = SymTable_getOrPut(oSymTable, acJeter, NULL, &iInserted);
+   ASSURE(ppvValue2 == ppvValue);
+   ASSURE(! iInserted);
 
-   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that a SymTable object reuses the storage of removed
+   bindings: after the first puts, putting as many bindings as were
+   removed allocates no new storage. Compiled with
+   -DSYMTABLE_NO_POOL, every binding is a new malloc instead. */
+
+static void testBindingReuse(void)
+{
+   enum {MAX_KEY_LENGTH = 12};
+   enum {BINDING_COUNT = 1000};
+   enum {CHURN_COUNT = 500};
+   enum {ROUND_COUNT = 4};
+
+   static int aiValues[BINDING_COUNT];
+
+   SymTable_T oSymTable;
+   struct SymTable_Stats sStats;
+   char acKey[MAX_KEY_LENGTH];
+   size_t uAllocations;
+   size_t uReuses;
+   int *piValue;
+   int iSuccessful;
+   int iRound;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the reuse of the storage of removed bindings.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   for (i = 0; i < BINDING_COUNT; i++)
    {
-      fprintf(stderr, "bindingcount must be numeric\n");
-      exit(EXIT_FAILURE);
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[i]);
+      ASSURE(iSuccessful);
    }
-   if (iBindingCount < 0)
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uBindingAllocations == BINDING_COUNT);
+   uAllocations = sStats.uBindingAllocations;
+   uReuses = sStats.uBindingReuses;
+
+   /* Remove CHURN_COUNT bindings and put them back, again and
+      again. */
+   for (iRound = 0; iRound < ROUND_COUNT; iRound++)
    {
-      fprintf(stderr, "bindingcount cannot be negative\n");
-      exit(EXIT_FAILURE);
+      for (i = 0; i < CHURN_COUNT; i++)
+      {
+         sprintf(acKey, "%d", i);
+         piValue = (int*)SymTable_remove(oSymTable, acKey);
+         ASSURE(piValue == &aiValues[i]);
+      }
+      for (i = 0; i < CHURN_COUNT; i++)
+      {
+         sprintf(acKey, "%d", i);
+         iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[i]);
+         ASSURE(iSuccessful);
+      }
+
+      SymTable_getStats(oSymTable, &sStats);
+      ASSURE(sStats.uBindingAllocations
+         == uAllocations + CHURN_COUNT);
+#ifdef SYMTABLE_NO_POOL
+      /* Every put needed new storage. */
+      ASSURE(sStats.uBindingReuses == uReuses);
+#else
+      /* Every put reused a removed binding, so the number of
+         bindings that needed new storage stayed flat. */
+      ASSURE(sStats.uBindingReuses == uReuses + CHURN_COUNT);
+      ASSURE(sStats.uBindingAllocations - sStats.uBindingReuses
+         == uAllocations - uReuses);
+#endif
+      uAllocations = sStats.uBindingAllocations;
+      uReuses = sStats.uBindingReuses;
    }
-   
-#ifndef S_SPLINT_S
-   setCpuTimeLimit();
+
+   for (i = 0; i < BINDING_COUNT; i++)
+   {
+      sprintf(acKey, "%d", i);
+      piValue = (int*)SymTable_get(oSymTable, acKey);
+      ASSURE(piValue == &aiValues[i]);
+   }
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Write into acLongKey a key of uLength characters that starts with
+   the decimal digits of i and continues with x's. acLongKey must
+   have room for uLength + 1 characters. */
+
+static void makeLongKey(char acLongKey[], size_t uLength, int i)
+{
+   size_t uDigits;
+
+   assert(acLongKey != NULL);
+
+   memset(acLongKey, 'x', uLength);
+   acLongKey[uLength] = '\0';
+   uDigits = (size_t)sprintf(acLongKey, "%d", i);
+   acLongKey[uDigits] = 'x';
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test a SymTable object made by SymTable_newRegion(): put bindings
+   with short keys and keys too long for the size classes, remove
+   half of them, put them again with other values, make sure that
+   every binding is found, and free the table. A memory checker
+   reports any binding that SymTable_free() leaves behind. */
+
+static void testRegion(void)
+{
+   enum {MAX_KEY_LENGTH = 12};
+   enum {LONG_KEY_LENGTH = 600};
+   enum {BINDING_COUNT = 1000};
+
+   static int aiValues[BINDING_COUNT];
+   static int aiNewValues[BINDING_COUNT];
+   static char acLongKey[LONG_KEY_LENGTH + 1];
+
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   int *piValue;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing a SymTable object made by SymTable_newRegion().\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   /* Free a region that never held a binding. */
+   oSymTable = SymTable_newRegion();
+   ASSURE(oSymTable != NULL);
+   SymTable_free(oSymTable);
+
+   oSymTable = SymTable_newRegion();
+   ASSURE(oSymTable != NULL);
+
+   /* Every tenth key is long, so that it does not fit any size
+      class. */
+   for (i = 0; i < BINDING_COUNT; i++)
+   {
+      if (i % 10 == 0)
+      {
+         makeLongKey(acLongKey, LONG_KEY_LENGTH, i);
+         iSuccessful = SymTable_put(oSymTable, acLongKey,
+            &aiValues[i]);
+      }
+      else
+      {
+         sprintf(acKey, "%d", i);
+         iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[i]);
+      }
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTable_getLength(oSymTable) == BINDING_COUNT);
+
+   /* Remove the short keys with an even index, then put them again
+      with new values. */
+   for (i = 0; i < BINDING_COUNT; i += 2)
+   {
+      if (i % 10 == 0)
+         continue;
+      sprintf(acKey, "%d", i);
+      piValue = (int*)SymTable_remove(oSymTable, acKey);
+      ASSURE(piValue == &aiValues[i]);
+      ASSURE(! SymTable_contains(oSymTable, acKey));
+   }
+   for (i = 0; i < BINDING_COUNT; i += 2)
+   {
+      if (i % 10 == 0)
+         continue;
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, &aiNewValues[i]);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTable_getLength(oSymTable) == BINDING_COUNT);
+
+   /* Remove a long key and put it back. */
+   makeLongKey(acLongKey, LONG_KEY_LENGTH, 0);
+   piValue = (int*)SymTable_remove(oSymTable, acLongKey);
+   ASSURE(piValue == &aiValues[0]);
+   iSuccessful = SymTable_put(oSymTable, acLongKey, &aiNewValues[0]);
+   ASSURE(iSuccessful);
+
+   for (i = 0; i < BINDING_COUNT; i++)
+   {
+      if (i % 10 == 0)
+      {
+         makeLongKey(acLongKey, LONG_KEY_LENGTH, i);
+         piValue = (int*)SymTable_get(oSymTable, acLongKey);
+         ASSURE(piValue == (i == 0 ? &aiNewValues[i] : &aiValues[i]));
+      }
+      else
+      {
+         sprintf(acKey, "%d", i);
+         piValue = (int*)SymTable_get(oSymTable, acKey);
+         ASSURE(piValue
+            == (i % 2 == 0 ? &aiNewValues[i] : &aiValues[i]));
+      }
+   }
+
+   SymTable_free(oSymTable);
+}
 #endif
 
-   testBasics();
-   testKeyComparison();
-   testKeyOwnership();
-   testRemove();
-   testMap();
-   testEmptyTable();
-   testEmptyKey();
-   testNullValue();
-   testLongKey();
-   testTableOfTables();
-   testCollisions();
-   testLargeTable(iBindingCount);
+/*--------------------------------------------------------------------*/
+
+#if defined(TEST_LIST) || defined(TEST_HASH)
+/* Put iBindingCount bindings into oSymTable, whose key is the index
+   of an element of aiValues and whose value is the address of that
+   element, and iterate over them with SymTable_iterBegin() and
+   SymTable_iterNext(). Stop halfway, search and replace values, and
+   continue. Make sure that each binding is returned exactly once
+   with its value. Free oSymTable. */
+
+static void iterateHalfway(SymTable_T oSymTable, int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 10};
+   enum {MAX_BINDINGS = 1000};
+
+   static int aiValues[MAX_BINDINGS];
+   static int aiVisits[MAX_BINDINGS];
+
+   struct SymTable_Iter sIter;
+   char acKey[MAX_KEY_LENGTH];
+   const char *pcKey;
+   void *pvValue;
+   int iVisited;
+   int iSuccessful;
+   int iIndex;
+   int i;
+
+   assert(oSymTable != NULL);
+   assert(iBindingCount <= MAX_BINDINGS);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[i]);
+      ASSURE(iSuccessful);
+      aiVisits[i] = 0;
+   }
+
+   /* Visit the first half of the bindings. */
+   SymTable_iterBegin(oSymTable, &sIter);
+   for (iVisited = 0; iVisited < iBindingCount / 2; iVisited++)
+   {
+      iSuccessful = SymTable_iterNext(oSymTable, &sIter, &pcKey,
+         &pvValue);
+      ASSURE(iSuccessful);
+      iIndex = atoi(pcKey);
+      ASSURE(pvValue == &aiValues[iIndex]);
+      aiVisits[iIndex]++;
+   }
+
+   /* Search every key, and replace every value with itself. */
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_get(oSymTable, acKey) == &aiValues[i]);
+      ASSURE(SymTable_replace(oSymTable, acKey, &aiValues[i])
+         == &aiValues[i]);
+   }
+
+   /* Visit the rest. */
+   while (SymTable_iterNext(oSymTable, &sIter, &pcKey, &pvValue))
+   {
+      iIndex = atoi(pcKey);
+      ASSURE(pvValue == &aiValues[iIndex]);
+      aiVisits[iIndex]++;
+      iVisited++;
+   }
+   ASSURE(iVisited == iBindingCount);
+   for (i = 0; i < iBindingCount; i++)
+      ASSURE(aiVisits[i] == 1);
+   ASSURE(! SymTable_iterNext(oSymTable, &sIter, &pcKey, &pvValue));
+
+   /* A scan that keeps neither keys nor values visits as many
+      bindings. */
+   iVisited = 0;
+   SymTable_iterBegin(oSymTable, &sIter);
+   while (SymTable_iterNext(oSymTable, &sIter, NULL, NULL))
+      iVisited++;
+   ASSURE(iVisited == iBindingCount);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+#ifdef TEST_HASH
+/* Iterate over hash tables at the edges of the buckets inside every
+   table, over one that has shrunk back into them, and over one that
+   is resizing incrementally. */
+
+static void iterateHashTables(void)
+{
+   enum {MAX_KEY_LENGTH = 10};
+   enum {GROW_BINDINGS = 600};
+
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   int iSuccessful;
+   int i;
+
+   /* The most bindings that the 7 buckets inside a hash table hold,
+      and one more, which moves them into 509 buckets. */
+   iterateHalfway(SymTable_new(), 7);
+   iterateHalfway(SymTable_new(), 8);
+
+   /* A table that has shrunk back into the buckets inside it. */
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   for (i = 0; i < GROW_BINDINGS; i++)
+   {
+      sprintf(acKey, "x%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, NULL);
+      ASSURE(iSuccessful);
+   }
+   for (i = 0; i < GROW_BINDINGS; i++)
+   {
+      sprintf(acKey, "x%d", i);
+      SymTable_remove(oSymTable, acKey);
+   }
+   iterateHalfway(oSymTable, 7);
+
+   /* A table whose scan starts during an incremental resize. */
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   SymTable_setIncrementalResize(oSymTable, 1);
+   iterateHalfway(oSymTable, GROW_BINDINGS);
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_iterBegin() and SymTable_iterNext() functions. */
+
+static void testIterate(void)
+{
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_iterBegin() and SymTable_iterNext()\n");
+   printf("functions.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   iterateHalfway(SymTable_new(), 0);
+   iterateHalfway(SymTable_new(), 1);
+   iterateHalfway(SymTable_new(), 2);
+   iterateHalfway(SymTable_new(), 5);
+   iterateHalfway(SymTable_new(), 600);
+
+#ifdef TEST_HASH
+   iterateHashTables();
+#endif
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+
+#if defined(TEST_HASH) || defined(TEST_ADAPTIVE)
+/* Make sure that oSymTable contains exactly the keys "0" to
+   "iCount - 1" of the keys up to iMaxCount, and that the value of
+   each is the address of the element of aiValues with its index. */
+
+static void checkKeys(SymTable_T oSymTable, int iCount, int iMaxCount,
+   int aiValues[])
+{
+   enum {MAX_KEY_LENGTH = 10};
+
+   char acKey[MAX_KEY_LENGTH];
+   int i;
+
+   assert(oSymTable != NULL);
+   assert(aiValues != NULL);
+
+   ASSURE(SymTable_getLength(oSymTable) == (size_t)iCount);
+   for (i = 0; i < iMaxCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_get(oSymTable, acKey)
+         == (i < iCount ? &aiValues[i] : NULL));
+   }
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+
+#ifdef TEST_HASH
+/* Return the number of buckets of hash table oSymTable. */
+
+static size_t countBuckets(SymTable_T oSymTable)
+{
+   size_t auCounts[2];
+
+   assert(oSymTable != NULL);
+
+   SymTable_getChainLengths(oSymTable, auCounts, 2);
+   return auCounts[0] + auCounts[1];
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that a hash table grows as bindings are put into it, shrinks
+   as they are removed, and keeps every binding that is left. */
+
+static void testShrink(void)
+{
+   enum {MAX_KEY_LENGTH = 10};
+   enum {BINDING_COUNT = 5000};
+
+   static int aiValues[BINDING_COUNT];
+
+   SymTable_T oSymTable;
+   struct SymTable_Stats sStats;
+   char acKey[MAX_KEY_LENGTH];
+   size_t uGrownResizes;
+   size_t uGrownBuckets;
+   int *piValue;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the growing and shrinking of a hash table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uResizes == 0);
+
+   for (i = 0; i < BINDING_COUNT; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[i]);
+      ASSURE(iSuccessful);
+   }
+   SymTable_getStats(oSymTable, &sStats);
+   uGrownResizes = sStats.uResizes;
+   uGrownBuckets = countBuckets(oSymTable);
+   ASSURE(uGrownResizes > 0);
+   ASSURE(uGrownBuckets >= BINDING_COUNT);
+
+   /* Remove the first half of the bindings, and make sure that
+      the rest can still be found. */
+   for (i = 0; i < BINDING_COUNT / 2; i++)
+   {
+      sprintf(acKey, "%d", i);
+      piValue = (int*)SymTable_remove(oSymTable, acKey);
+      ASSURE(piValue == &aiValues[i]);
+   }
+   for (i = 0; i < BINDING_COUNT; i++)
+   {
+      sprintf(acKey, "%d", i);
+      piValue = (int*)SymTable_get(oSymTable, acKey);
+      ASSURE(piValue == (i < BINDING_COUNT / 2 ? NULL : &aiValues[i]));
+   }
+
+   /* Remove the other half. */
+   for (i = BINDING_COUNT / 2; i < BINDING_COUNT; i++)
+   {
+      sprintf(acKey, "%d", i);
+      piValue = (int*)SymTable_remove(oSymTable, acKey);
+      ASSURE(piValue == &aiValues[i]);
+   }
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uResizes > uGrownResizes);
+   ASSURE(countBuckets(oSymTable) < uGrownBuckets);
+
+   /* Make sure that the emptied table still works. */
+   for (i = 0; i < BINDING_COUNT; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(! SymTable_contains(oSymTable, acKey));
+   }
+   iSuccessful = SymTable_put(oSymTable, "0", &aiValues[0]);
+   ASSURE(iSuccessful);
+   piValue = (int*)SymTable_get(oSymTable, "0");
+   ASSURE(piValue == &aiValues[0]);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that a hash table moves its bindings from the 7 buckets
+   inside it to an array of 509 buckets and back, keeping every
+   binding. Freeing the table afterward must not free the buckets
+   inside it, which a memory checker would report. */
+
+static void testInlineBuckets(void)
+{
+   enum {MAX_KEY_LENGTH = 12};
+   enum {INLINE_BUCKETS = 7};
+   enum {GROWN_BUCKETS = 509};
+   enum {BINDING_COUNT = 8};
+
+   static int aiValues[BINDING_COUNT];
+
+   SymTable_T oSymTable;
+   struct SymTable_Stats sStats;
+   char acKey[MAX_KEY_LENGTH];
+   int *piValue;
+   int iSuccessful;
+   int iRound;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the buckets inside a hash table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   ASSURE(countBuckets(oSymTable) == INLINE_BUCKETS);
+
+   /* Grow out of the buckets inside the table and shrink back into
+      them twice, so that the second growth starts from buckets that
+      were used before. */
+   for (iRound = 0; iRound < 2; iRound++)
+   {
+      for (i = 0; i < BINDING_COUNT; i++)
+      {
+         ASSURE(countBuckets(oSymTable) == INLINE_BUCKETS);
+         sprintf(acKey, "%d", i);
+         iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[i]);
+         ASSURE(iSuccessful);
+      }
+      ASSURE(countBuckets(oSymTable) == GROWN_BUCKETS);
+      checkKeys(oSymTable, BINDING_COUNT, BINDING_COUNT,
+         aiValues);
+
+      for (i = BINDING_COUNT; countBuckets(oSymTable)
+         == GROWN_BUCKETS; i--)
+      {
+         ASSURE(i > 0);
+         sprintf(acKey, "%d", i - 1);
+         piValue = (int*)SymTable_remove(oSymTable, acKey);
+         ASSURE(piValue == &aiValues[i - 1]);
+      }
+      ASSURE(countBuckets(oSymTable) == INLINE_BUCKETS);
+      checkKeys(oSymTable, i, BINDING_COUNT, aiValues);
+
+      for (; i > 0; i--)
+      {
+         sprintf(acKey, "%d", i - 1);
+         piValue = (int*)SymTable_remove(oSymTable, acKey);
+         ASSURE(piValue == &aiValues[i - 1]);
+      }
+      checkKeys(oSymTable, 0, BINDING_COUNT, aiValues);
+   }
+
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uResizes == 4);
+
+   /* Free the table while its bindings are in the buckets inside
+      it. */
+   for (i = 0; i < BINDING_COUNT - 1; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[i]);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(countBuckets(oSymTable) == INLINE_BUCKETS);
+   SymTable_free(oSymTable);
+
+   /* Free a table that never held a binding. */
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uBindingAllocations == 0);
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that lowering the load factor of a populated hash table makes
+   it grow on the next puts, and that raising it lets the table
+   shrink on the next removes but never below the bucket count that
+   its bindings need. */
+
+static void testLoadFactor(void)
+{
+   enum {MAX_KEY_LENGTH = 12};
+   enum {BINDING_COUNT = 2000};
+   enum {EXTRA_COUNT = 10};
+   enum {LOW_FACTOR = 4};
+   enum {HIGH_FACTOR = 8};
+
+   static int aiValues[BINDING_COUNT + EXTRA_COUNT];
+
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   size_t uBuckets;
+   int *piValue;
+   int iSuccessful;
+   int iCount;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing SymTable_setLoadFactor() on a populated table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   for (iCount = 0; iCount < BINDING_COUNT; iCount++)
+   {
+      sprintf(acKey, "%d", iCount);
+      iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[iCount]);
+      ASSURE(iSuccessful);
+   }
+   uBuckets = countBuckets(oSymTable);
+   ASSURE(uBuckets >= BINDING_COUNT);
+
+   /* Allow a quarter of a binding per bucket. The next puts grow
+      the table until it has room for that. */
+   SymTable_setLoadFactor(oSymTable, 1.0 / LOW_FACTOR);
+   ASSURE(countBuckets(oSymTable) == uBuckets);
+   for (; iCount < BINDING_COUNT + EXTRA_COUNT; iCount++)
+   {
+      sprintf(acKey, "%d", iCount);
+      iSuccessful = SymTable_put(oSymTable, acKey, &aiValues[iCount]);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(countBuckets(oSymTable)
+      >= (size_t)LOW_FACTOR * (size_t)iCount);
+   checkKeys(oSymTable, iCount, BINDING_COUNT + EXTRA_COUNT,
+      aiValues);
+
+   /* Allow 8 bindings per bucket. The next removes shrink the table,
+      but never so far that it holds more than that. */
+   uBuckets = countBuckets(oSymTable);
+   SymTable_setLoadFactor(oSymTable, HIGH_FACTOR);
+   ASSURE(countBuckets(oSymTable) == uBuckets);
+   while (iCount > BINDING_COUNT / 2)
+   {
+      iCount--;
+      sprintf(acKey, "%d", iCount);
+      piValue = (int*)SymTable_remove(oSymTable, acKey);
+      ASSURE(piValue == &aiValues[iCount]);
+      ASSURE((size_t)HIGH_FACTOR * countBuckets(oSymTable)
+         >= (size_t)iCount);
+   }
+   ASSURE(countBuckets(oSymTable) < uBuckets);
+   checkKeys(oSymTable, iCount, BINDING_COUNT + EXTRA_COUNT,
+      aiValues);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_intern(), SymTable_atomKey(),
+   SymTable_putAtom() and SymTable_getAtom() functions. */
+
+static void testAtoms(void)
+{
+   SymTable_T oSymTable;
+   SymTable_T oSymTable2;
+   SymAtom_T oJeter;
+   SymAtom_T oJeter2;
+   SymAtom_T oMantle;
+   SymAtom_T oRuth;
+   struct SymTable_Stats sStats;
+   char acJeter[] = "Jeter";
+   char acJeter2[] = "Jeter";
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char acRightField[] = "Right Field";
+   char *pcValue;
+   int iSuccessful;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing interned keys.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   /* Interning the same key twice returns the same atom, which
+      holds a copy of the key. */
+
+   oJeter = SymTable_intern(acJeter);
+   ASSURE(oJeter != NULL);
+   oJeter2 = SymTable_intern(acJeter2);
+   ASSURE(oJeter2 == oJeter);
+   oMantle = SymTable_intern("Mantle");
+   ASSURE(oMantle != NULL);
+   ASSURE(oMantle != oJeter);
+   oRuth = SymTable_intern("Ruth");
+   ASSURE(oRuth != NULL);
+   ASSURE(strcmp(SymTable_atomKey(oJeter), "Jeter") == 0);
+   ASSURE(SymTable_atomKey(oJeter) != acJeter);
+   strcpy(acJeter, "xxxxx");
+   ASSURE(strcmp(SymTable_atomKey(oJeter), "Jeter") == 0);
+
+   /* Lookups by atom match lookups by string, whichever way the
+      binding was put. */
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   iSuccessful = SymTable_putAtom(oSymTable, oJeter, acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_putAtom(oSymTable, oJeter2, acCenterField);
+   ASSURE(! iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acCenterField);
+   ASSURE(! iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Mantle", acCenterField);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_putAtom(oSymTable, oMantle, acShortstop);
+   ASSURE(! iSuccessful);
+   ASSURE(SymTable_getLength(oSymTable) == 2);
+
+   pcValue = (char*)SymTable_getAtom(oSymTable, oJeter);
+   ASSURE(pcValue == acShortstop);
+   pcValue = (char*)SymTable_get(oSymTable, "Jeter");
+   ASSURE(pcValue == acShortstop);
+   pcValue = (char*)SymTable_getAtom(oSymTable, oMantle);
+   ASSURE(pcValue == acCenterField);
+   pcValue = (char*)SymTable_get(oSymTable, "Mantle");
+   ASSURE(pcValue == acCenterField);
+   pcValue = (char*)SymTable_getAtom(oSymTable, oRuth);
+   ASSURE(pcValue == NULL);
+
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uSharedKeyBytes > 0);
+
+   /* The same atom can be put into another table. */
+
+   oSymTable2 = SymTable_new();
+   ASSURE(oSymTable2 != NULL);
+   iSuccessful = SymTable_putAtom(oSymTable2, oJeter, acRightField);
+   ASSURE(iSuccessful);
+   pcValue = (char*)SymTable_getAtom(oSymTable2, oJeter);
+   ASSURE(pcValue == acRightField);
+   pcValue = (char*)SymTable_getAtom(oSymTable, oJeter);
+   ASSURE(pcValue == acShortstop);
+
+   /* Removing a binding by string removes it for its atom too. */
+
+   pcValue = (char*)SymTable_remove(oSymTable, "Jeter");
+   ASSURE(pcValue == acShortstop);
+   pcValue = (char*)SymTable_getAtom(oSymTable, oJeter);
+   ASSURE(pcValue == NULL);
+   ASSURE(SymTable_intern("Jeter") == oJeter);
+
+   SymTable_free(oSymTable2);
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put the keys from "*piCount" on into oSymTable, whose value is
+   the address of the element of aiValues with the same index,
+   until oSymTable has started uResizes resizes. Add the number of
+   keys put to *piCount. */
+
+static void putUntilResize(SymTable_T oSymTable, int *piCount,
+   int iMaxCount, int aiValues[], size_t uResizes)
+{
+   enum {MAX_KEY_LENGTH = 12};
+
+   struct SymTable_Stats sStats;
+   char acKey[MAX_KEY_LENGTH];
+   int iSuccessful;
+
+   assert(oSymTable != NULL);
+   assert(piCount != NULL);
+   assert(aiValues != NULL);
+
+   SymTable_getStats(oSymTable, &sStats);
+   while (sStats.uResizes < uResizes)
+   {
+      ASSURE(*piCount < iMaxCount);
+      sprintf(acKey, "%d", *piCount);
+      iSuccessful = SymTable_put(oSymTable, acKey,
+         &aiValues[*piCount]);
+      ASSURE(iSuccessful);
+      (*piCount)++;
+      SymTable_getStats(oSymTable, &sStats);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that SymTable_setHashFunction() rehashes the bindings of a
+   table that has resized several times, and of one that is in the
+   middle of an incremental resize if iIncremental is 1 (TRUE). */
+
+static void testRehash(int iIncremental)
+{
+   enum {MAX_KEY_LENGTH = 12};
+   enum {MAX_COUNT = 5000};
+   enum {CHECK_INTERVAL = 97};
+
+   static int aiValues[MAX_COUNT];
+
+   SymTable_T oSymTable;
+   struct SymTable_Stats sStats;
+   char acKey[MAX_KEY_LENGTH];
+   size_t uMigrationPuts;
+   int *piValue;
+   int iCount = 0;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing SymTable_setHashFunction() on a populated\n");
+   printf("table%s.\n",
+      iIncremental ? " that resizes incrementally" : "");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   SymTable_setIncrementalResize(oSymTable, iIncremental);
+
+   /* Switch to FNV-1a right after the third resize starts. */
+   putUntilResize(oSymTable, &iCount, MAX_COUNT, aiValues, 3);
+   if (iIncremental)
+   {
+      /* Make sure that the resize is still in progress. */
+      SymTable_getStats(oSymTable, &sStats);
+      uMigrationPuts = sStats.uMigrationPuts;
+      sprintf(acKey, "%d", iCount);
+      SymTable_put(oSymTable, acKey, &aiValues[iCount]);
+      iCount++;
+      SymTable_getStats(oSymTable, &sStats);
+      ASSURE(sStats.uMigrationPuts == uMigrationPuts + 1);
+   }
+   SymTable_setHashFunction(oSymTable, SYMHASH_FNV1A);
+   checkKeys(oSymTable, iCount, MAX_COUNT, aiValues);
+
+   /* Switch to wyhash right after the next resize starts. */
+   putUntilResize(oSymTable, &iCount, MAX_COUNT, aiValues, 4);
+   SymTable_setHashFunction(oSymTable, SYMHASH_WY);
+   checkKeys(oSymTable, iCount, MAX_COUNT, aiValues);
+
+   /* Remove every binding, from the newest one, making sure that the
+      rest can still be found. */
+   for (i = iCount; i > 0; i--)
+   {
+      sprintf(acKey, "%d", i - 1);
+      piValue = (int*)SymTable_remove(oSymTable, acKey);
+      ASSURE(piValue == &aiValues[i - 1]);
+      ASSURE(SymTable_getLength(oSymTable) == (size_t)(i - 1));
+      if (i % CHECK_INTERVAL == 0)
+         checkKeys(oSymTable, i - 1, MAX_COUNT, aiValues);
+   }
+   checkKeys(oSymTable, 0, MAX_COUNT, aiValues);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that a key made by SymTable_makeKey() behaves like the same
+   string key in SymTable_putK(), SymTable_containsK(),
+   SymTable_getK() and SymTable_removeK(), in a table that uses the
+   default hash function and in one that uses eFunction. */
+
+static void testPrehashedKeys(enum SymHash_Function eFunction)
+{
+   SymTable_T oSymTable;
+   SymTable_Key sJeter;
+   SymTable_Key sMantle;
+   SymTable_Key sEmpty;
+   char acJeter[] = "Jeter";
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char *pcValue;
+   int iSuccessful;
+   int iRound;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing prehashed keys, also in a table hashed with %s.\n",
+      SymHash_name(eFunction));
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   sJeter = SymTable_makeKey(acJeter);
+   sMantle = SymTable_makeKey("Mantle");
+   sEmpty = SymTable_makeKey("");
+   ASSURE(sJeter.pcKey == acJeter);
+   ASSURE(sJeter.uLength == strlen(acJeter));
+
+   for (iRound = 0; iRound < 2; iRound++)
+   {
+      oSymTable = SymTable_new();
+      ASSURE(oSymTable != NULL);
+      if (iRound == 1)
+         SymTable_setHashFunction(oSymTable, eFunction);
+
+      /* A binding put with a key handle is found by its string,
+         and the other way around. */
+      iSuccessful = SymTable_putK(oSymTable, sJeter, acShortstop);
+      ASSURE(iSuccessful);
+      iSuccessful = SymTable_put(oSymTable, "Jeter", acCenterField);
+      ASSURE(! iSuccessful);
+      iSuccessful = SymTable_put(oSymTable, "Mantle", acCenterField);
+      ASSURE(iSuccessful);
+      iSuccessful = SymTable_putK(oSymTable, sMantle, acShortstop);
+      ASSURE(! iSuccessful);
+      iSuccessful = SymTable_putK(oSymTable, sEmpty, acShortstop);
+      ASSURE(iSuccessful);
+      ASSURE(SymTable_getLength(oSymTable) == 3);
+
+      ASSURE(SymTable_containsK(oSymTable, sJeter));
+      ASSURE(SymTable_containsK(oSymTable, sMantle));
+      ASSURE(SymTable_contains(oSymTable, ""));
+      pcValue = (char*)SymTable_getK(oSymTable, sJeter);
+      ASSURE(pcValue == acShortstop);
+      pcValue = (char*)SymTable_get(oSymTable, "Jeter");
+      ASSURE(pcValue == acShortstop);
+      pcValue = (char*)SymTable_getK(oSymTable, sMantle);
+      ASSURE(pcValue == acCenterField);
+
+      /* The table copied the key of the handle. */
+      strcpy(acJeter, "xxxxx");
+      pcValue = (char*)SymTable_get(oSymTable, "Jeter");
+      ASSURE(pcValue == acShortstop);
+      strcpy(acJeter, "Jeter");
+
+      /* Replace and remove with a handle and with a string. */
+      pcValue = (char*)
+         SymTable_replace(oSymTable, "Jeter", acCenterField);
+      ASSURE(pcValue == acShortstop);
+      pcValue = (char*)SymTable_getK(oSymTable, sJeter);
+      ASSURE(pcValue == acCenterField);
+      pcValue = (char*)SymTable_removeK(oSymTable, sJeter);
+      ASSURE(pcValue == acCenterField);
+      ASSURE(! SymTable_containsK(oSymTable, sJeter));
+      ASSURE(! SymTable_contains(oSymTable, "Jeter"));
+      pcValue = (char*)SymTable_removeK(oSymTable, sJeter);
+      ASSURE(pcValue == NULL);
+      pcValue = (char*)SymTable_remove(oSymTable, "Mantle");
+      ASSURE(pcValue == acCenterField);
+      ASSURE(SymTable_getK(oSymTable, sMantle) == NULL);
+      pcValue = (char*)SymTable_removeK(oSymTable, sEmpty);
+      ASSURE(pcValue == acShortstop);
+      ASSURE(SymTable_getLength(oSymTable) == 0);
+
+      SymTable_free(oSymTable);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return the next number of a pseudo-random sequence whose state
+   is *puState. The sequence does not depend on the C library, so
+   that the tests that use it always perform the same operations. */
+
+static unsigned long nextRandom(unsigned long *puState)
+{
+   assert(puState != NULL);
+
+   *puState = (*puState * 1103515245UL + 12345UL) & 0x7fffffffUL;
+   return *puState >> 8;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_putN(), SymTable_replaceN(),
+   SymTable_containsN(), SymTable_getN() and SymTable_removeN()
+   functions with keys that contain '\0', with a prefix of a stored
+   key passed at the address of that key, and with a long sequence of
+   pseudo-random operations whose results are checked against an
+   array of the keys that should be present. */
+
+static void testLengthKeys(void)
+{
+   enum {KEY_COUNT = 2000};
+   enum {MAX_KEY_LENGTH = 8};
+   enum {OPERATION_COUNT = 200000};
+   enum {PREFIX_KEY_COUNT = 50};
+   enum {PREFIX_KEY_LENGTH = 6};
+
+   static char aacKeys[KEY_COUNT][MAX_KEY_LENGTH + 1];
+   static size_t auLengths[KEY_COUNT];
+   static int aiPresent[KEY_COUNT];
+   static int aiValues[KEY_COUNT];
+   static int aiNewValues[KEY_COUNT];
+   static char aacPrefixKeys[PREFIX_KEY_COUNT][PREFIX_KEY_LENGTH + 1];
+
+   SymTable_T oSymTable;
+   struct SymTable_Iter sIter;
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char acRightField[] = "Right Field";
+   const char *pcStoredKey;
+   size_t uKeyLength;
+   char *pcValue;
+   void *pvExpected;
+   unsigned long uState = 1;
+   size_t uLength = 0;
+   long lOperation;
+   int iSuccessful;
+   int iKey;
+   int i;
+   int j;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing keys with lengths.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   /* Keys that differ only after an embedded '\0' are different
+      keys, and so are a key and its prefixes. */
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   iSuccessful = SymTable_putN(oSymTable, "a\0b", 3, acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_putN(oSymTable, "a\0c", 3, acCenterField);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_putN(oSymTable, "a\0bx", 3, acRightField);
+   ASSURE(! iSuccessful);
+   iSuccessful = SymTable_putN(oSymTable, "a", 1, acRightField);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_putN(oSymTable, "axxx", 0, acRightField);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_getLength(oSymTable) == 4);
+   pcValue = (char*)SymTable_getN(oSymTable, "a\0b", 3);
+   ASSURE(pcValue == acShortstop);
+   pcValue = (char*)SymTable_getN(oSymTable, "a\0c", 3);
+   ASSURE(pcValue == acCenterField);
+   pcValue = (char*)SymTable_get(oSymTable, "a");
+   ASSURE(pcValue == acRightField);
+   ASSURE(SymTable_contains(oSymTable, ""));
+   ASSURE(! SymTable_containsN(oSymTable, "a\0", 2));
+   pcValue = (char*)
+      SymTable_replaceN(oSymTable, "a\0c", 3, acShortstop);
+   ASSURE(pcValue == acCenterField);
+   pcValue = (char*)SymTable_removeN(oSymTable, "a\0b", 3);
+   ASSURE(pcValue == acShortstop);
+   ASSURE(! SymTable_containsN(oSymTable, "a\0b", 3));
+   pcValue = (char*)SymTable_getN(oSymTable, "a\0c", 3);
+   ASSURE(pcValue == acShortstop);
+   SymTable_free(oSymTable);
+
+   /* A prefix of a stored key, passed at the address of the stored
+      key, is not the stored key. Each key is put into a table of
+      its own, whose few buckets many of its prefixes share. */
+
+   for (i = 0; i < 2 * PREFIX_KEY_COUNT; i++)
+   {
+      if (i % 2 == 0)
+         oSymTable = SymTable_new();
+      else
+         oSymTable = SymTable_newBorrowedKeys();
+      ASSURE(oSymTable != NULL);
+      sprintf(aacPrefixKeys[i / 2], "p%05d", i / 2);
+      iSuccessful = SymTable_put(oSymTable, aacPrefixKeys[i / 2],
+         acCenterField);
+      ASSURE(iSuccessful);
+
+      /* finds the stored copy of the key, or the caller's key if
+         the table borrowed it */
+      SymTable_iterBegin(oSymTable, &sIter);
+      iSuccessful = SymTable_iterNext(oSymTable, &sIter, &pcStoredKey,
+         NULL);
+      ASSURE(iSuccessful);
+      uKeyLength = strlen(pcStoredKey);
+      for (j = 0; j < (int)uKeyLength; j++)
+      {
+         ASSURE(! SymTable_containsN(oSymTable, pcStoredKey,
+            (size_t)j));
+         ASSURE(SymTable_getN(oSymTable, pcStoredKey, (size_t)j)
+            == NULL);
+         ASSURE(SymTable_removeN(oSymTable, pcStoredKey, (size_t)j)
+            == NULL);
+      }
+
+      /* The prefix can then be added as a key of its own. */
+      iSuccessful = SymTable_putN(oSymTable, pcStoredKey, 3,
+         acShortstop);
+      ASSURE(iSuccessful);
+      pcValue = (char*)SymTable_getN(oSymTable, pcStoredKey, 3);
+      ASSURE(pcValue == acShortstop);
+      pcValue = (char*)SymTable_get(oSymTable, aacPrefixKeys[i / 2]);
+      ASSURE(pcValue == acCenterField);
+      ASSURE(SymTable_getLength(oSymTable) == 2);
+      SymTable_free(oSymTable);
+   }
+
+   /* Make KEY_COUNT different keys of '\0', 'a' and 'b', none of
+      which is followed by '\0'. */
+
+   i = 0;
+   while (i < KEY_COUNT)
+   {
+      auLengths[i] = nextRandom(&uState) % (MAX_KEY_LENGTH + 1);
+      for (j = 0; j < (int)auLengths[i]; j++)
+         aacKeys[i][j] = "\0ab"[nextRandom(&uState) % 3];
+      aacKeys[i][auLengths[i]] = 'x';
+      for (j = 0; j < i; j++)
+         if (auLengths[j] == auLengths[i]
+             && memcmp(aacKeys[j], aacKeys[i], auLengths[i]) == 0)
+            break;
+      if (j == i)
+         i++;
+   }
+
+   /* Perform random operations on random keys. */
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   for (lOperation = 0; lOperation < OPERATION_COUNT; lOperation++)
+   {
+      iKey = (int)(nextRandom(&uState) % KEY_COUNT);
+      pvExpected = aiPresent[iKey] ? &aiValues[iKey] : NULL;
+      switch (nextRandom(&uState) % 5)
+      {
+         case 0:
+            iSuccessful = SymTable_putN(oSymTable, aacKeys[iKey],
+               auLengths[iKey], &aiValues[iKey]);
+            ASSURE(iSuccessful == ! aiPresent[iKey]);
+            if (iSuccessful)
+               uLength++;
+            aiPresent[iKey] = 1;
+            break;
+         case 1:
+            ASSURE(SymTable_getN(oSymTable, aacKeys[iKey],
+               auLengths[iKey]) == pvExpected);
+            break;
+         case 2:
+            ASSURE(SymTable_containsN(oSymTable, aacKeys[iKey],
+               auLengths[iKey]) == aiPresent[iKey]);
+            break;
+         case 3:
+            /* replaces the value with itself or back, so that the
+               value of a present key stays &aiValues[iKey] */
+            ASSURE(SymTable_replaceN(oSymTable, aacKeys[iKey],
+               auLengths[iKey], &aiNewValues[iKey]) == pvExpected);
+            if (aiPresent[iKey])
+               ASSURE(SymTable_replaceN(oSymTable, aacKeys[iKey],
+                  auLengths[iKey], &aiValues[iKey])
+                  == &aiNewValues[iKey]);
+            break;
+         default:
+            ASSURE(SymTable_removeN(oSymTable, aacKeys[iKey],
+               auLengths[iKey]) == pvExpected);
+            if (aiPresent[iKey])
+               uLength--;
+            aiPresent[iKey] = 0;
+            break;
+      }
+      ASSURE(SymTable_getLength(oSymTable) == uLength);
+   }
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test handling of key ownership by a table made by
+   SymTable_newBorrowedKeys(), which stores the caller's key instead
+   of a copy, so that the expectations of testKeyOwnership() are
+   inverted. */
+
+static void testBorrowedKeyOwnership(void)
+{
+   enum {MAX_KEY_LENGTH = 10};
+
+   SymTable_T oSymTable;
+   struct SymTable_Iter sIter;
+   struct SymTable_Stats sStats;
+   char acKey[MAX_KEY_LENGTH];
+   char acCenterField[] = "CenterField";
+   const char *pcStoredKey;
+   char *pcValue;
+   int iSuccessful;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing key ownership of a table with borrowed keys.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_newBorrowedKeys();
+   ASSURE(oSymTable != NULL);
+   strcpy(acKey, "Mantle");
+   iSuccessful = SymTable_put(oSymTable, acKey, acCenterField);
+   ASSURE(iSuccessful);
+   pcValue = (char*)SymTable_get(oSymTable, "Mantle");
+   ASSURE(pcValue == acCenterField);
+
+   /* The binding's key is the caller's array itself. */
+   SymTable_iterBegin(oSymTable, &sIter);
+   iSuccessful = SymTable_iterNext(oSymTable, &sIter, &pcStoredKey,
+      NULL);
+   ASSURE(iSuccessful);
+   ASSURE(pcStoredKey == acKey);
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uSharedKeyBytes == sizeof("Mantle"));
+
+   /* Changing the array changes the binding's key, which can then
+      no longer be found. */
+   strcpy(acKey, "xxx");
+   pcValue = (char*)SymTable_get(oSymTable, "Mantle");
+   ASSURE(pcValue == NULL);
+   strcpy(acKey, "Mantle");
+   pcValue = (char*)SymTable_get(oSymTable, "Mantle");
+   ASSURE(pcValue == acCenterField);
+
+   /* Nor can it be found through the array itself. "Mantll" has the
+      length of "Mantle" and hashes to the same one of 7 buckets. */
+   strcpy(acKey, "Mantll");
+   pcValue = (char*)SymTable_get(oSymTable, acKey);
+   ASSURE(pcValue == NULL);
+   ASSURE(! SymTable_contains(oSymTable, acKey));
+   strcpy(acKey, "Mantle");
+   pcValue = (char*)SymTable_get(oSymTable, acKey);
+   ASSURE(pcValue == acCenterField);
+
+   /* Removing the binding leaves the array alone. */
+   pcValue = (char*)SymTable_remove(oSymTable, "Mantle");
+   ASSURE(pcValue == acCenterField);
+   ASSURE(strcmp(acKey, "Mantle") == 0);
+
+   iSuccessful = SymTable_put(oSymTable, acKey, acCenterField);
+   ASSURE(iSuccessful);
+   SymTable_free(oSymTable);
+   ASSURE(strcmp(acKey, "Mantle") == 0);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_putBatch() function. */
+
+static void testPutBatch(void)
+{
+   enum {MAX_KEY_LENGTH = 10};
+   enum {BATCH_SIZE = 300};
+   enum {DISTINCT_KEY_COUNT = 200};
+
+   static char aacKeys[BATCH_SIZE][MAX_KEY_LENGTH];
+   static const char *apcKeys[BATCH_SIZE];
+   static const void *apvValues[BATCH_SIZE];
+   static int aiValues[BATCH_SIZE];
+   static int aiResults[BATCH_SIZE];
+
+   SymTable_T oSymTable;
+   const char *apcFewKeys[3];
+   const void *apvFewValues[3];
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   size_t uAdded;
+   void *pvValue;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_putBatch() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   /* An empty batch adds nothing. */
+   uAdded = SymTable_putBatch(oSymTable, NULL, NULL, 0, NULL);
+   ASSURE(uAdded == 0);
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+
+   /* A batch whose keys repeat, two of which are already in the
+      table, adds each other key once, with the value of its first
+      occurrence. */
+   iSuccessful = SymTable_put(oSymTable, "7", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "150", acCenterField);
+   ASSURE(iSuccessful);
+   for (i = 0; i < BATCH_SIZE; i++)
+   {
+      sprintf(aacKeys[i], "%d", i % DISTINCT_KEY_COUNT);
+      apcKeys[i] = aacKeys[i];
+      apvValues[i] = &aiValues[i];
+      aiResults[i] = -1;
+   }
+   uAdded = SymTable_putBatch(oSymTable, apcKeys, apvValues,
+      BATCH_SIZE, aiResults);
+   ASSURE(uAdded == DISTINCT_KEY_COUNT - 2);
+   ASSURE(SymTable_getLength(oSymTable) == DISTINCT_KEY_COUNT);
+   for (i = 0; i < BATCH_SIZE; i++)
+      ASSURE(aiResults[i] == (i < DISTINCT_KEY_COUNT
+         && i != 7 && i != 150));
+   for (i = 0; i < DISTINCT_KEY_COUNT; i++)
+   {
+      pvValue = SymTable_get(oSymTable, aacKeys[i]);
+      if (i == 7)
+         ASSURE(pvValue == acShortstop);
+      else if (i == 150)
+         ASSURE(pvValue == acCenterField);
+      else
+         ASSURE(pvValue == &aiValues[i]);
+   }
+
+   /* aiResults can be NULL. */
+   apcFewKeys[0] = "Jeter";
+   apcFewKeys[1] = "0";
+   apcFewKeys[2] = "Jeter";
+   apvFewValues[0] = acShortstop;
+   apvFewValues[1] = acShortstop;
+   apvFewValues[2] = acCenterField;
+   uAdded = SymTable_putBatch(oSymTable, apcFewKeys, apvFewValues, 3,
+      NULL);
+   ASSURE(uAdded == 1);
+   ASSURE(SymTable_getLength(oSymTable) == DISTINCT_KEY_COUNT + 1);
+   pvValue = SymTable_get(oSymTable, "Jeter");
+   ASSURE(pvValue == acShortstop);
+   pvValue = SymTable_get(oSymTable, "0");
+   ASSURE(pvValue == &aiValues[0]);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_getMany() function, in a table that resizes
+   incrementally, so that some of its bindings may still be in the
+   old buckets. */
+
+static void testGetMany(void)
+{
+   enum {MAX_KEY_LENGTH = 10};
+   enum {KEY_COUNT = 300};
+
+   static char aacKeys[KEY_COUNT][MAX_KEY_LENGTH];
+   static const char *apcKeys[KEY_COUNT];
+   static void *apvValues[KEY_COUNT];
+   static int aiValues[KEY_COUNT];
+
+   SymTable_T oSymTable;
+   struct SymTable_Stats sStats;
+   size_t uFound;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_getMany() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   SymTable_setIncrementalResize(oSymTable, 1);
+
+   /* An empty batch finds nothing. */
+   uFound = SymTable_getMany(oSymTable, NULL, 0, NULL);
+   ASSURE(uFound == 0);
+
+   /* Put the keys with even numbers. */
+   for (i = 0; i < KEY_COUNT; i++)
+   {
+      sprintf(aacKeys[i], "%d", i);
+      apcKeys[i] = aacKeys[i];
+      if (i % 2 == 0)
+      {
+         iSuccessful = SymTable_put(oSymTable, aacKeys[i],
+            &aiValues[i]);
+         ASSURE(iSuccessful);
+      }
+   }
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uMigrationPuts > 0);
+
+   /* Every key is looked up, and each missing one gets NULL. */
+   for (i = 0; i < KEY_COUNT; i++)
+      apvValues[i] = apcKeys;
+   uFound = SymTable_getMany(oSymTable, apcKeys, KEY_COUNT, apvValues);
+   ASSURE(uFound == KEY_COUNT / 2);
+   for (i = 0; i < KEY_COUNT; i++)
+      ASSURE(apvValues[i] == (i % 2 == 0 ? &aiValues[i] : NULL));
+
+   /* A key that appears twice is found twice. */
+   apcKeys[1] = aacKeys[0];
+   uFound = SymTable_getMany(oSymTable, apcKeys, 2, apvValues);
+   ASSURE(uFound == 2);
+   ASSURE(apvValues[0] == &aiValues[0]);
+   ASSURE(apvValues[1] == &aiValues[0]);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* The number of bindings that testMapReduce() visits. */
+
+enum {MAP_BINDING_COUNT = 10000};
+
+/* The values of the bindings of testMapReduce(), and the number of
+   times each binding has been visited. */
+
+static long alMapValues[MAP_BINDING_COUNT];
+static int aiMapVisits[MAP_BINDING_COUNT];
+
+/*--------------------------------------------------------------------*/
+
+/* Add the long value pvValue of the binding whose key is pcKey to
+   the sum *pvSum. */
+
+static void addValue(const char *pcKey, void *pvValue, void *pvSum)
+{
+   assert(pcKey != NULL);
+   assert(pvValue != NULL);
+   assert(pvSum != NULL);
+
+   *(long*)pvSum += *(long*)pvValue;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Count a visit of the binding whose key is pcKey and whose value
+   pvValue is an element of alMapValues. Different bindings count
+   in different elements of aiMapVisits, so several threads can
+   call this function at once. pvExtra is unused. */
+
+static void countVisit(const char *pcKey, void *pvValue, void *pvExtra)
+{
+   assert(pcKey != NULL);
+   assert(pvValue != NULL);
+   assert(pvExtra == NULL);
+
+   aiMapVisits[(long*)pvValue - alMapValues]++;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return a new sum of 0 for a thread of SymTable_mapReduce(), or
+   NULL if insufficient memory is available. pvExtra is unused. */
+
+static void *beginSum(void *pvExtra)
+{
+   long *plSum;
+
+   (void)pvExtra;
+
+   plSum = (long*)malloc(sizeof(long));
+   if (plSum != NULL)
+      *plSum = 0;
+   return plSum;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Add the sum *pvLocal of a thread of SymTable_mapReduce() to the
+   total *pvTotal, and free it. */
+
+static void endSum(void *pvLocal, void *pvTotal)
+{
+   assert(pvLocal != NULL);
+   assert(pvTotal != NULL);
+
+   *(long*)pvTotal += *(long*)pvLocal;
+   free(pvLocal);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_mapParallel() and SymTable_mapReduce() functions
+   against SymTable_map(), with several threads, in a table that
+   resizes incrementally, so that some of its bindings may still be
+   in the old buckets. */
+
+static void testMapReduce(void)
+{
+   enum {MAX_KEY_LENGTH = 10};
+   enum {THREADS = 4};
+
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   long lSerialSum = 0;
+   long lSum;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_mapParallel() and\n");
+   printf("SymTable_mapReduce() functions.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   SymTable_setIncrementalResize(oSymTable, 1);
+
+   /* An empty table visits nothing. */
+   SymTable_mapParallel(oSymTable, countVisit, NULL, THREADS);
+   lSum = 0;
+   SymTable_mapReduce(oSymTable, addValue, beginSum, endSum, &lSum,
+      THREADS);
+   ASSURE(lSum == 0);
+
+   for (i = 0; i < MAP_BINDING_COUNT; i++)
+   {
+      sprintf(acKey, "%d", i);
+      alMapValues[i] = (long)i * i % 1000 + 1;
+      iSuccessful = SymTable_put(oSymTable, acKey, &alMapValues[i]);
+      ASSURE(iSuccessful);
+   }
+   SymTable_map(oSymTable, addValue, &lSerialSum);
+
+   /* Each binding is visited exactly once. */
+   SymTable_mapParallel(oSymTable, countVisit, NULL, THREADS);
+   for (i = 0; i < MAP_BINDING_COUNT; i++)
+      ASSURE(aiMapVisits[i] == 1);
+
+   /* The sums of the threads add up to the serial sum. */
+   lSum = 0;
+   SymTable_mapReduce(oSymTable, addValue, beginSum, endSum, &lSum,
+      THREADS);
+   ASSURE(lSum == lSerialSum);
+   lSum = 0;
+   SymTable_mapReduce(oSymTable, addValue, beginSum, endSum, &lSum, 0);
+   ASSURE(lSum == lSerialSum);
+
+   /* Without pfBegin and pfEnd, one thread sums into pvExtra. */
+   lSum = 0;
+   SymTable_mapReduce(oSymTable, addValue, NULL, NULL, &lSum, 1);
+   ASSURE(lSum == lSerialSum);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Make oSymTable resize incrementally. */
+
+static void setIncrementalResize(SymTable_T oSymTable)
+{
+   assert(oSymTable != NULL);
+
+   SymTable_setIncrementalResize(oSymTable, 1);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Make every resize of oSymTable that has enough buckets move its
+   bindings with 4 threads. */
+
+static void setParallelResize(SymTable_T oSymTable)
+{
+   assert(oSymTable != NULL);
+
+   SymTable_setParallelResize(oSymTable, 1, 4);
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+
+#ifdef TEST_CONCURRENT
+/* The number of threads that testThreads() runs at once, the number
+   of keys that each of them puts and removes, and the number of
+   times it puts and removes all of them. testLockFreeReads() runs
+   STRESS_ROUND_COUNT rounds instead, to give a thread more chances
+   to be stopped in the middle of a read. */
+
+enum {THREAD_COUNT = 4};
+enum {KEYS_PER_THREAD = 5000};
+enum {ROUND_COUNT = 3};
+enum {STRESS_ROUND_COUNT = 20};
+
+/* The keys of each thread of testThreads(). */
+
+enum {MAX_THREAD_KEY_LENGTH = 16};
+static char aacThreadKeys[THREAD_COUNT][KEYS_PER_THREAD]
+   [MAX_THREAD_KEY_LENGTH];
+
+/* A ThreadTest is the work of one thread of testThreads(). */
+
+struct ThreadTest
+{
+   /* The table that the thread uses. */
+   SymTable_T oSymTable;
+
+   /* The number of the thread, which chooses its keys. */
+   int iThread;
+
+   /* The number of times that the thread uses all of its keys. */
+   int iRounds;
+};
+
+/*--------------------------------------------------------------------*/
+
+/* Put and remove the keys of the thread described by the ThreadTest
+   pvTest as many times as its rounds, checking each result. The
+   value of each binding is its key. Then put them all once more,
+   and remove the ones with odd indexes. Return NULL. */
+
+static void *putAndRemove(void *pvTest)
+{
+   struct ThreadTest *psTest = (struct ThreadTest*)pvTest;
+   char (*aacKeys)[MAX_THREAD_KEY_LENGTH];
+   char *pcValue;
+   int iSuccessful;
+   int iRound;
+   int i;
+
+   assert(psTest != NULL);
+
+   aacKeys = aacThreadKeys[psTest->iThread];
+   for (iRound = 0; iRound <= psTest->iRounds; iRound++)
+   {
+      for (i = 0; i < KEYS_PER_THREAD; i++)
+      {
+         iSuccessful = SymTable_put(psTest->oSymTable, aacKeys[i],
+            aacKeys[i]);
+         ASSURE(iSuccessful);
+      }
+      for (i = 0; i < KEYS_PER_THREAD; i++)
+      {
+         pcValue = (char*)SymTable_get(psTest->oSymTable, aacKeys[i]);
+         ASSURE(pcValue == aacKeys[i]);
+      }
+      for (i = 0; i < KEYS_PER_THREAD; i++)
+      {
+         if (iRound == psTest->iRounds && i % 2 == 0)
+            continue;
+         pcValue = (char*)
+            SymTable_remove(psTest->oSymTable, aacKeys[i]);
+         ASSURE(pcValue == aacKeys[i]);
+      }
+   }
+   return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Add 1 to the count *pvCount of the bindings whose value is their
+   key pcKey. */
+
+static void countOwnValues(const char *pcKey, void *pvValue,
+   void *pvCount)
+{
+   assert(pcKey != NULL);
+   assert(pvCount != NULL);
+
+   if (pvValue != NULL && strcmp((char*)pvValue, pcKey) == 0)
+      (*(size_t*)pvCount)++;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_getShardStats() function, and that one shard of
+   a table made by SymTable_newSharded() grows on its own. */
+
+static void testShardStats(void)
+{
+   enum {SHARD_COUNT = 16};
+   enum {MAX_KEY_LENGTH = 10};
+   enum {BINDING_COUNT = 20000};
+
+   SymTable_T oSymTable;
+   struct SymTable_Stats asStats[SHARD_COUNT];
+   struct SymTable_Stats sStats;
+   struct SymTable_Stats sSum;
+   char acKey[MAX_KEY_LENGTH];
+   size_t uShards;
+   size_t uResized;
+   int iSuccessful;
+   int i;
+   int j;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the statistics of the shards of a table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   /* A table that is not sharded has one shard. */
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", NULL);
+   ASSURE(iSuccessful);
+   uShards = SymTable_getShardStats(oSymTable, asStats, SHARD_COUNT);
+   ASSURE(uShards == 1);
+   ASSURE(asStats[0].uBindingAllocations == 1);
+   SymTable_free(oSymTable);
+
+   oSymTable = SymTable_newSharded(SHARD_COUNT, 4);
+   ASSURE(oSymTable != NULL);
+   uShards = SymTable_getShardStats(oSymTable, NULL, 0);
+   ASSURE(uShards == SHARD_COUNT);
+
+   /* Put bindings until the first shard resizes. It is the only one
+      that has. */
+   uResized = 0;
+   for (i = 0; i < BINDING_COUNT && uResized == 0; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, NULL);
+      ASSURE(iSuccessful);
+      SymTable_getShardStats(oSymTable, asStats, SHARD_COUNT);
+      for (j = 0; j < SHARD_COUNT; j++)
+         uResized += asStats[j].uResizes;
+   }
+   ASSURE(uResized == 1);
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uResizes == 1);
+
+   /* Put the rest, and check that the counts of the shards add up
+      to those of the table. */
+   for (; i < BINDING_COUNT; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, NULL);
+      ASSURE(iSuccessful);
+   }
+   memset(&sSum, 0, sizeof(sSum));
+   uShards = SymTable_getShardStats(oSymTable, asStats, SHARD_COUNT);
+   ASSURE(uShards == SHARD_COUNT);
+   for (j = 0; j < SHARD_COUNT; j++)
+   {
+      ASSURE(asStats[j].uBindingAllocations > 0);
+      sSum.uResizes += asStats[j].uResizes;
+      sSum.uBindingAllocations += asStats[j].uBindingAllocations;
+      if (asStats[j].uMaxMoved > sSum.uMaxMoved)
+         sSum.uMaxMoved = asStats[j].uMaxMoved;
+   }
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sSum.uResizes == sStats.uResizes);
+   ASSURE(sSum.uBindingAllocations == sStats.uBindingAllocations);
+   ASSURE(sSum.uBindingAllocations == BINDING_COUNT);
+   ASSURE(sSum.uMaxMoved == sStats.uMaxMoved);
+   ASSURE(sStats.uResizes >= SHARD_COUNT);
+
+   /* A resize of one shard moves only the bindings of that shard,
+      which are fewer than twice the share of one shard. */
+   ASSURE(sStats.uMaxMoved > 0);
+   ASSURE(sStats.uMaxMoved < 2 * BINDING_COUNT / SHARD_COUNT);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Read the keys of the threads of testLockFreeReads() as many times
+   as the rounds of the ThreadTest pvTest. The keys
+   of the threads from THREAD_COUNT / 2 on are never removed, so
+   each of them has to be found with its own value. The others are
+   being put and removed, so each of them has to be found with its
+   own value or not at all. Return NULL. */
+
+static void *readKeys(void *pvTest)
+{
+   struct ThreadTest *psTest = (struct ThreadTest*)pvTest;
+   char *pcValue;
+   int iRound;
+   int i;
+   int j;
+
+   assert(psTest != NULL);
+
+   for (iRound = 0; iRound < psTest->iRounds; iRound++)
+      for (i = 0; i < THREAD_COUNT; i++)
+         for (j = 0; j < KEYS_PER_THREAD; j++)
+         {
+            pcValue = (char*)
+               SymTable_get(psTest->oSymTable, aacThreadKeys[i][j]);
+            if (i >= THREAD_COUNT / 2)
+               ASSURE(pcValue == aacThreadKeys[i][j]);
+            else
+               ASSURE(pcValue == NULL
+                  || pcValue == aacThreadKeys[i][j]);
+         }
+   return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test a table made by SymTable_newLockFreeReads(). The threads
+   below THREAD_COUNT / 2 put and remove their keys, growing and
+   shrinking the table, while the others read every key without
+   locks, so that a binding or bucket array freed too early is read
+   after it is freed. Built with -fsanitize=address, as the Makefile
+   does for testsymtableconcurrentasan, such a read stops the
+   test. */
+
+static void testLockFreeReads(void)
+{
+   pthread_t aThreads[THREAD_COUNT];
+   struct ThreadTest asTests[THREAD_COUNT];
+   struct SymTable_Stats sStats;
+   SymTable_T oSymTable;
+   char *pcValue;
+   int iSuccessful;
+   int i;
+   int j;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing %d threads that read a table without locks while\n",
+      THREAD_COUNT / 2);
+   printf("%d others change it.\n", THREAD_COUNT - THREAD_COUNT / 2);
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_newLockFreeReads(4);
+   ASSURE(oSymTable != NULL);
+   if (oSymTable == NULL)
+      return;
+
+   /* Put the keys that are never removed. */
+   for (i = 0; i < THREAD_COUNT; i++)
+      for (j = 0; j < KEYS_PER_THREAD; j++)
+         sprintf(aacThreadKeys[i][j], "%d.%d", i, j);
+   for (i = THREAD_COUNT / 2; i < THREAD_COUNT; i++)
+      for (j = 0; j < KEYS_PER_THREAD; j++)
+      {
+         iSuccessful = SymTable_put(oSymTable, aacThreadKeys[i][j],
+            aacThreadKeys[i][j]);
+         ASSURE(iSuccessful);
+      }
+
+   for (i = 0; i < THREAD_COUNT; i++)
+   {
+      asTests[i].oSymTable = oSymTable;
+      asTests[i].iThread = i;
+      asTests[i].iRounds = STRESS_ROUND_COUNT;
+      iSuccessful = pthread_create(&aThreads[i], NULL,
+         i < THREAD_COUNT / 2 ? putAndRemove : readKeys,
+         &asTests[i]) == 0;
+      ASSURE(iSuccessful);
+   }
+   for (i = 0; i < THREAD_COUNT; i++)
+      pthread_join(aThreads[i], NULL);
+
+   /* The writers left the keys with even indexes. */
+   ASSURE(SymTable_getLength(oSymTable)
+      == (THREAD_COUNT - THREAD_COUNT / 2) * KEYS_PER_THREAD
+         + THREAD_COUNT / 2 * ((KEYS_PER_THREAD + 1) / 2));
+   for (i = 0; i < THREAD_COUNT; i++)
+      for (j = 0; j < KEYS_PER_THREAD; j++)
+      {
+         pcValue = (char*)SymTable_get(oSymTable, aacThreadKeys[i][j]);
+         ASSURE(pcValue == (i >= THREAD_COUNT / 2 || j % 2 == 0
+            ? aacThreadKeys[i][j] : NULL));
+      }
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.uResizes > 0);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that THREAD_COUNT threads can put and remove different keys
+   of oSymTable, which is described by pcDescription, at the same
+   time, and that exactly the bindings that they left are in it
+   afterwards. Free oSymTable. */
+
+static void testThreads(SymTable_T oSymTable, const char *pcDescription)
+{
+   pthread_t aThreads[THREAD_COUNT];
+   struct ThreadTest asTests[THREAD_COUNT];
+   char *pcValue;
+   size_t uCount = 0;
+   int iSuccessful;
+   int i;
+   int j;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing %d threads that use %s.\n", THREAD_COUNT,
+      pcDescription);
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   ASSURE(oSymTable != NULL);
+   if (oSymTable == NULL)
+      return;
+
+   for (i = 0; i < THREAD_COUNT; i++)
+      for (j = 0; j < KEYS_PER_THREAD; j++)
+         sprintf(aacThreadKeys[i][j], "%d.%d", i, j);
+
+   for (i = 0; i < THREAD_COUNT; i++)
+   {
+      asTests[i].oSymTable = oSymTable;
+      asTests[i].iThread = i;
+      asTests[i].iRounds = ROUND_COUNT;
+      iSuccessful = pthread_create(&aThreads[i], NULL, putAndRemove,
+         &asTests[i]) == 0;
+      ASSURE(iSuccessful);
+   }
+   for (i = 0; i < THREAD_COUNT; i++)
+      pthread_join(aThreads[i], NULL);
+
+   /* Each thread left the keys with even indexes. */
+   ASSURE(SymTable_getLength(oSymTable)
+      == THREAD_COUNT * ((KEYS_PER_THREAD + 1) / 2));
+   for (i = 0; i < THREAD_COUNT; i++)
+      for (j = 0; j < KEYS_PER_THREAD; j++)
+      {
+         pcValue = (char*)SymTable_get(oSymTable, aacThreadKeys[i][j]);
+         ASSURE(pcValue == (j % 2 == 0 ? aacThreadKeys[i][j] : NULL));
+      }
+   SymTable_map(oSymTable, countOwnValues, &uCount);
+   ASSURE(uCount == SymTable_getLength(oSymTable));
+
+   SymTable_free(oSymTable);
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+
+#ifdef TEST_TREE
+/* A Scan records the bindings that an ordered map visits. */
+
+struct Scan
+{
+   /* The number of bindings visited. */
+   int iCount;
+
+   /* 1 (TRUE) if each key was greater than the one before it. */
+   int iAscending;
+
+   /* The first and last keys visited, or "" if there were none. */
+   char acFirst[16];
+   char acLast[16];
+};
+
+/*--------------------------------------------------------------------*/
+
+/* Record the visit of the binding whose key is pcKey in the Scan
+   pvScan. pvValue is unused. */
+
+static void recordVisit(const char *pcKey, void *pvValue, void *pvScan)
+{
+   struct Scan *psScan = (struct Scan*)pvScan;
+
+   assert(pcKey != NULL);
+   assert(psScan != NULL);
+   assert(strlen(pcKey) < sizeof(psScan->acLast));
+
+   (void)pvValue;
+
+   if (psScan->iCount == 0)
+      strcpy(psScan->acFirst, pcKey);
+   else if (strcmp(psScan->acLast, pcKey) >= 0)
+      psScan->iAscending = 0;
+   strcpy(psScan->acLast, pcKey);
+   psScan->iCount++;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Visit the bindings of oSymTable from pcLow to pcHigh, or those
+   starting with pcPrefix if it is not NULL, and return what was
+   visited. */
+
+static struct Scan scan(SymTable_T oSymTable, const char *pcLow,
+   const char *pcHigh, const char *pcPrefix)
+{
+   struct Scan sScan;
+
+   assert(oSymTable != NULL);
+
+   sScan.iCount = 0;
+   sScan.iAscending = 1;
+   strcpy(sScan.acFirst, "");
+   strcpy(sScan.acLast, "");
+   if (pcPrefix != NULL)
+      SymTable_mapPrefix(oSymTable, pcPrefix, recordVisit, &sScan);
+   else
+      SymTable_mapRange(oSymTable, pcLow, pcHigh, recordVisit, &sScan);
+   return sScan;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_mapRange() and SymTable_mapPrefix() functions of
+   a B+-tree with many leaves, and the splits, borrows and merges of
+   its nodes as bindings are put in descending order and removed in
+   several patterns. */
+
+static void testRanges(void)
+{
+   enum {MAX_KEY_LENGTH = 10};
+   enum {BINDING_COUNT = 1000};
+
+   SymTable_T oSymTable;
+   struct Scan sScan;
+   char acKey[MAX_KEY_LENGTH];
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_mapRange() and SymTable_mapPrefix()\n");
+   printf("functions.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   /* An empty tree visits nothing. */
+   sScan = scan(oSymTable, NULL, NULL, NULL);
+   ASSURE(sScan.iCount == 0);
+   sScan = scan(oSymTable, NULL, NULL, "");
+   ASSURE(sScan.iCount == 0);
+
+   /* Put the keys k0000 to k0999 in descending order, splitting the
+      leftmost leaf again and again. */
+   for (i = BINDING_COUNT - 1; i >= 0; i--)
+   {
+      sprintf(acKey, "k%04d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, NULL);
+      ASSURE(iSuccessful);
+   }
+
+   /* A NULL bound is no bound. */
+   sScan = scan(oSymTable, NULL, NULL, NULL);
+   ASSURE(sScan.iCount == BINDING_COUNT);
+   ASSURE(sScan.iAscending);
+   ASSURE(strcmp(sScan.acFirst, "k0000") == 0);
+   ASSURE(strcmp(sScan.acLast, "k0999") == 0);
+   sScan = scan(oSymTable, NULL, "k0010", NULL);
+   ASSURE(sScan.iCount == 10);
+   ASSURE(strcmp(sScan.acLast, "k0009") == 0);
+   sScan = scan(oSymTable, "k0990", NULL, NULL);
+   ASSURE(sScan.iCount == 10);
+   ASSURE(strcmp(sScan.acFirst, "k0990") == 0);
+
+   /* A range across many leaves includes its low bound and excludes
+      its high bound. */
+   sScan = scan(oSymTable, "k0100", "k0200", NULL);
+   ASSURE(sScan.iCount == 100);
+   ASSURE(sScan.iAscending);
+   ASSURE(strcmp(sScan.acFirst, "k0100") == 0);
+   ASSURE(strcmp(sScan.acLast, "k0199") == 0);
+
+   /* Bounds that are not keys. */
+   sScan = scan(oSymTable, "k0100x", "k0102", NULL);
+   ASSURE(sScan.iCount == 1);
+   ASSURE(strcmp(sScan.acFirst, "k0101") == 0);
+   sScan = scan(oSymTable, "a", "z", NULL);
+   ASSURE(sScan.iCount == BINDING_COUNT);
+
+   /* An empty range, and a low bound above the high bound. */
+   sScan = scan(oSymTable, "k0500", "k0500", NULL);
+   ASSURE(sScan.iCount == 0);
+   sScan = scan(oSymTable, "k0500", "k0100", NULL);
+   ASSURE(sScan.iCount == 0);
+   sScan = scan(oSymTable, "z", NULL, NULL);
+   ASSURE(sScan.iCount == 0);
+
+   /* Prefixes. The empty prefix matches every key. */
+   sScan = scan(oSymTable, NULL, NULL, "");
+   ASSURE(sScan.iCount == BINDING_COUNT);
+   ASSURE(sScan.iAscending);
+   sScan = scan(oSymTable, NULL, NULL, "k01");
+   ASSURE(sScan.iCount == 100);
+   ASSURE(sScan.iAscending);
+   ASSURE(strcmp(sScan.acFirst, "k0100") == 0);
+   ASSURE(strcmp(sScan.acLast, "k0199") == 0);
+   sScan = scan(oSymTable, NULL, NULL, "k0999");
+   ASSURE(sScan.iCount == 1);
+   sScan = scan(oSymTable, NULL, NULL, "k1");
+   ASSURE(sScan.iCount == 0);
+   sScan = scan(oSymTable, NULL, NULL, "j");
+   ASSURE(sScan.iCount == 0);
+   sScan = scan(oSymTable, NULL, NULL, "k0999x");
+   ASSURE(sScan.iCount == 0);
+
+   /* Remove every other key, so that leaves borrow from and merge
+      with their siblings, and check the order of the rest. */
+   for (i = 0; i < BINDING_COUNT; i += 2)
+   {
+      sprintf(acKey, "k%04d", i);
+      ASSURE(SymTable_contains(oSymTable, acKey));
+      SymTable_remove(oSymTable, acKey);
+   }
+   sScan = scan(oSymTable, NULL, NULL, NULL);
+   ASSURE(sScan.iCount == BINDING_COUNT / 2);
+   ASSURE(sScan.iAscending);
+   ASSURE(strcmp(sScan.acFirst, "k0001") == 0);
+   sScan = scan(oSymTable, NULL, NULL, "k01");
+   ASSURE(sScan.iCount == 50);
+
+   /* Remove a block from the middle, then the rest from the end. */
+   for (i = 301; i < 701; i += 2)
+   {
+      sprintf(acKey, "k%04d", i);
+      SymTable_remove(oSymTable, acKey);
+   }
+   sScan = scan(oSymTable, "k0250", "k0750", NULL);
+   ASSURE(sScan.iCount == 50);
+   ASSURE(sScan.iAscending);
+   ASSURE(strcmp(sScan.acFirst, "k0251") == 0);
+   ASSURE(strcmp(sScan.acLast, "k0749") == 0);
+   for (i = BINDING_COUNT - 1; i >= 0; i -= 2)
+   {
+      sprintf(acKey, "k%04d", i);
+      SymTable_remove(oSymTable, acKey);
+      ASSURE(! SymTable_contains(oSymTable, acKey));
+   }
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+   sScan = scan(oSymTable, NULL, NULL, NULL);
+   ASSURE(sScan.iCount == 0);
+
+   /* The emptied tree still works. */
+   iSuccessful = SymTable_put(oSymTable, "k0500", NULL);
+   ASSURE(iSuccessful);
+   sScan = scan(oSymTable, NULL, NULL, "k05");
+   ASSURE(sScan.iCount == 1);
+
+   SymTable_free(oSymTable);
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+
+#ifdef TEST_ADAPTIVE
+/* Test that the bindings of an adaptive table survive moving from
+   its small array into a hash table at 9 bindings and back at 4,
+   in both directions, and that keys that differ only in the case of
+   a letter are different keys. */
+
+static void testPromotion(void)
+{
+   enum {MAX_KEY_LENGTH = 10};
+   enum {MAX_COUNT = 20};
+
+   static int aiValues[MAX_COUNT];
+
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char *pcValue;
+   int iSuccessful;
+   int iRound;
+   int iCount;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the moves of an adaptive table between its small\n");
+   printf("array and its hash table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   /* Grow past the small array and shrink below the demotion point
+      twice, checking every key after each change. */
+   iCount = 0;
+   for (iRound = 0; iRound < 2; iRound++)
+   {
+      for (; iCount < MAX_COUNT; iCount++)
+      {
+         sprintf(acKey, "%d", iCount);
+         iSuccessful = SymTable_put(oSymTable, acKey,
+            &aiValues[iCount]);
+         ASSURE(iSuccessful);
+         checkKeys(oSymTable, iCount + 1, MAX_COUNT, aiValues);
+      }
+      for (; iCount > 0; iCount--)
+      {
+         sprintf(acKey, "%d", iCount - 1);
+         pcValue = (char*)SymTable_remove(oSymTable, acKey);
+         ASSURE(pcValue == (char*)&aiValues[iCount - 1]);
+         checkKeys(oSymTable, iCount - 1, MAX_COUNT, aiValues);
+      }
+   }
+
+   /* Go back and forth across the edges of the small array and of
+      the demotion point. */
+   for (iCount = 0; iCount < 9; iCount++)
+   {
+      sprintf(acKey, "%d", iCount);
+      SymTable_put(oSymTable, acKey, &aiValues[iCount]);
+   }
+   for (iRound = 0; iRound < 3; iRound++)
+   {
+      for (; iCount > 3; iCount--)
+      {
+         sprintf(acKey, "%d", iCount - 1);
+         SymTable_remove(oSymTable, acKey);
+      }
+      checkKeys(oSymTable, iCount, MAX_COUNT, aiValues);
+      for (; iCount < 9; iCount++)
+      {
+         sprintf(acKey, "%d", iCount);
+         SymTable_put(oSymTable, acKey, &aiValues[iCount]);
+      }
+      checkKeys(oSymTable, iCount, MAX_COUNT, aiValues);
+   }
+
+   /* Keys that differ only in case, in the small array and in the
+      hash table. */
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "jeter", acCenterField);
+   ASSURE(iSuccessful);
+   pcValue = (char*)SymTable_get(oSymTable, "Jeter");
+   ASSURE(pcValue == acShortstop);
+   pcValue = (char*)SymTable_get(oSymTable, "jeter");
+   ASSURE(pcValue == acCenterField);
+   pcValue = (char*)SymTable_remove(oSymTable, "jeter");
+   ASSURE(pcValue == acCenterField);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+
+   SymTable_free(oSymTable);
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable ADT.  Write the output of the tests to stdout.
+   As always, argc is the command-line argument count, argv contains
+   the command-line arguments, and argv[0] is the name of the
+   executable binary file. argv[1] is the number of bindings to put
+   into a potentially large SymTable object.  Exit with EXIT_FAILURE
+   if argv[1] is missing or not numeric.  Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iBindingCount;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+   
+#ifndef S_SPLINT_S
+   setCpuTimeLimit();
+#endif
+
+   testBasics();
+   testKeyComparison();
+   testKeyOwnership();
+   testRemove();
+   testMap();
+   testEmptyTable();
+   testEmptyKey();
+   testNullValue();
+   testLongKey();
+   testTableOfTables();
+   testCollisions();
+#if defined(TEST_LIST) || defined(TEST_HASH)
+   testUpsert();
+   testRegion();
+   testBindingReuse();
+   testIterate();
+#endif
+#ifdef TEST_HASH
+   testShrink();
+   testInlineBuckets();
+   testLoadFactor();
+   testAtoms();
+   testPrehashedKeys(SYMHASH_WY);
+   testRehash(0);
+   testRehash(1);
+   testLengthKeys();
+   testBorrowedKeyOwnership();
+   testPutBatch();
+   testGetMany();
+   testMapReduce();
+#endif
+#ifdef TEST_TREE
+   testRanges();
+#endif
+#ifdef TEST_ADAPTIVE
+   testPromotion();
+#endif
+#ifdef TEST_CONCURRENT
+   testThreads(SymTable_new(), "a striped table");
+   testThreads(SymTable_newConcurrent(1), "a table with one stripe");
+   testThreads(SymTable_newLockFreeReads(4),
+      "a table with lock free reads");
+   testLockFreeReads();
+   testThreads(SymTable_newSharded(16, 4), "a sharded table");
+   testShardStats();
+#endif
+   testLargeTable(iBindingCount, NULL, "");
+#ifdef TEST_HASH
+   testLargeTable(iBindingCount, setIncrementalResize,
+      " that resizes incrementally");
+   testLargeTable(iBindingCount, setParallelResize,
+      " that resizes with several threads");
+#endif
 
    printf("------------------------------------------------------\n");
    printf("End of %s.\n", argv[0]);